@@ -1,3 +1,4 @@
+#include <algorithm>
 #include "p_set.h"
 
 persistent_set::persistent_set() : root(nullptr) {}
@@ -54,83 +55,83 @@ std::pair<persistent_set::iterator, bool> persistent_set::insert(persistent_set:
     }
 
     this->invalidate_iterators();
+    this->root = insert(this->root, x);
 
-    std::stack<node_ptr> path;
-    node_ptr curr = this->root, copy, prev = nullptr;
-    while (curr != nullptr) {
-        copy = std::shared_ptr<node>(new node(curr->data));
+    return { this->find(x), true };
+}
 
-        if (prev != nullptr) {
-            copy->data < prev->data ? prev->left = copy : prev->right = copy;
-        } else {
-            this->root = copy;
-        }
+void persistent_set::erase(persistent_set::iterator it) {
+    root = erase(root, *it);
+    invalidate_iterators();
+    return;
+}
 
-        if (x < curr->data) {
-            copy->right = curr->right;
-            curr = curr->left;
-        } else {
-            copy->left = curr->left;
-            curr = curr->right;
-        }
+int persistent_set::height(node_ptr const& r) {
+    return r == nullptr ? 0 : r->height;
+}
 
-        prev = copy;
-        path.push(copy);
-    }
+persistent_set::node_ptr persistent_set::make_node(value_type data, node_ptr left, node_ptr right) {
+    int h = std::max(height(left), height(right)) + 1;
+    return std::make_shared<node>(data, left, right, h);
+}
 
-    curr = std::shared_ptr<node>(new node(x));
-    if (prev == nullptr) {
-        this->root = curr;
-    } else {
-        if (x < prev->data) {
-            prev->left = curr;
-        } else {
-            prev->right = curr;
+// heights of (left) and (right) differ by at most two, one or two rotations fix it
+persistent_set::node_ptr persistent_set::balance(value_type data, node_ptr left, node_ptr right) {
+    if (height(left) > height(right) + 1) {
+        if (height(left->left) >= height(left->right)) {
+            return make_node(left->data, left->left, make_node(data, left->right, right));
         }
+        node_ptr mid = left->right;
+        return make_node(mid->data, make_node(left->data, left->left, mid->left), make_node(data, mid->right, right));
     }
-    path.push(curr);
-
-    return { persistent_set::iterator(path, *this), true };
+    if (height(right) > height(left) + 1) {
+        if (height(right->right) >= height(right->left)) {
+            return make_node(right->data, make_node(data, left, right->left), right->right);
+        }
+        node_ptr mid = right->left;
+        return make_node(mid->data, make_node(data, left, mid->left), make_node(right->data, mid->right, right->right));
+    }
+    return make_node(data, left, right);
 }
 
-void persistent_set::erase(persistent_set::iterator it) {
-    node_ptr copy, prev, my = it.path.top();
-    it.path.pop();
-
-    if (my->left == nullptr && my->right == nullptr) {
-        prev = nullptr;
-    } else if (my->left == nullptr) {
-        prev = my->right;
-    } else if (my->right == nullptr) {
-        prev = my->left;
-    } else {
-        std::stack<node_ptr> empty;
-        value_type mindata = (it.set.find_min(my->right, empty)).path.top()->data;
-
-        persistent_set small;
-        small.root = my;
-        small.erase(small.find(mindata));
+persistent_set::node_ptr persistent_set::insert(node_ptr const& r, value_type x) {
+    if (r == nullptr) {
+        return std::make_shared<node>(x);
+    }
+    if (x < r->data) {
+        return balance(r->data, insert(r->left, x), r->right);
+    }
+    return balance(r->data, r->left, insert(r->right, x));
+}
 
-        prev = small.root;
-        prev->data = mindata;
+persistent_set::node_ptr persistent_set::erase(node_ptr const& r, value_type x) {
+    if (r == nullptr) {
+        return r;
+    }
+    if (x < r->data) {
+        return balance(r->data, erase(r->left, x), r->right);
+    }
+    if (r->data < x) {
+        return balance(r->data, r->left, erase(r->right, x));
     }
 
-    while (!it.path.empty()) {
-        copy = std::shared_ptr<node>(new node(it.path.top()->data));
-        if (my->data < copy->data) {
-            copy->right = it.path.top()->right;
-            copy->left = prev;
-        } else {
-            copy->right = prev;
-            copy->left = it.path.top()->left;
-        }
-        it.path.pop();
-        prev = copy;
+    if (r->left == nullptr) {
+        return r->right;
+    }
+    if (r->right == nullptr) {
+        return r->left;
     }
+    value_type min;
+    node_ptr right = erase_min(r->right, min);
+    return balance(min, r->left, right);
+}
 
-    root = prev;
-    invalidate_iterators();
-    return;
+persistent_set::node_ptr persistent_set::erase_min(node_ptr const& r, value_type& min) {
+    if (r->left == nullptr) {
+        min = r->data;
+        return r->right;
+    }
+    return balance(r->data, erase_min(r->left, min), r->right);
 }
 
 persistent_set::iterator persistent_set::find_max(node_ptr r, std::stack<node_ptr> path) const {
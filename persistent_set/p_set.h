@@ -23,21 +23,25 @@ private:
 
     typedef std::shared_ptr<node> node_ptr;
 
+    // nodes form an AVL tree: heights of the children of a node differ by at most one;
+    // a node is never changed after it is shared, updates copy the path from the root
     struct node
     {
         node() {};
         node(value_type data) :
             data(data)
         {};
-        node(value_type data, node_ptr left, node_ptr right) :
+        node(value_type data, node_ptr left, node_ptr right, int height) :
             data(data),
             left(left),
-            right(right)
+            right(right),
+            height(height)
         {};
 
         value_type data;
         node_ptr left = nullptr;
         node_ptr right = nullptr;
+        int height = 1;
     };
 
     node_ptr root;
@@ -62,6 +66,13 @@ public:
     iterator end() const;
 
 private:
+    static int height(node_ptr const& r);
+    static node_ptr make_node(value_type data, node_ptr left, node_ptr right);
+    static node_ptr balance(value_type data, node_ptr left, node_ptr right);
+    static node_ptr insert(node_ptr const& r, value_type x);
+    static node_ptr erase(node_ptr const& r, value_type x);
+    static node_ptr erase_min(node_ptr const& r, value_type& min);
+
     void invalidate_iterators();
     iterator find_max(node_ptr r, std::stack<persistent_set::node_ptr> path) const;
     iterator find_min(node_ptr r, std::stack<persistent_set::node_ptr> path) const;
@@ -0,0 +1,357 @@
+; calculator of expressions in reverse Polish notation, one expression per line:
+;   2 3 + 4 *
+; numbers are non-negative decimals, operators are + - * / %, results may be negative,
+; / and % round towards zero; every line prints its result or an error, empty lines are skipped;
+; an operand is an entry of three qwords on the operand stack: address, length and sign (1 if negative)
+
+MAX_OPERANDS:   equ             4096
+
+                section         .text
+
+                global          _start
+
+_start:
+                call		select_kernels
+
+.next_line:
+                xor		rcx, rcx
+                call		alloc_qwords
+                mov		r12, rax		; everything allocated for the line is freed at once
+                xor		r15, r15		; number of operands
+
+.next_token:
+                call		read_char
+                or		rax, rax
+                js		.end_of_input
+                cmp		rax, 0x0a
+                je		.end_of_line
+                cmp		rax, ' '
+                je		.next_token
+                cmp		rax, 0x09
+                je		.next_token
+                cmp		rax, '+'
+                je		.add
+                cmp		rax, '-'
+                je		.sub
+                cmp		rax, '*'
+                je		.mul
+                cmp		rax, '/'
+                je		.div
+                cmp		rax, '%'
+                je		.mod
+                cmp		rax, '0'
+                jb		.invalid_char
+                cmp		rax, '9'
+                ja		.invalid_char
+
+                call		unread_char
+                call		scan_long
+                cmp		r15, MAX_OPERANDS
+                jae		.too_many_operands
+                xor		rax, rax
+                call		push_operand
+                jmp		.next_token
+
+.sub:
+                call		pop_operands
+                jc		.few_operands
+                xor		r11, 1			; a - b = a + (-b)
+                jmp		.add_signed
+.add:
+                call		pop_operands
+                jc		.few_operands
+.add_signed:
+                call		add_signed
+                jmp		.push_result
+
+.mul:
+                call		pop_operands
+                jc		.few_operands
+                call		mul_signed
+                jmp		.push_result
+
+.div:
+                call		pop_operands
+                jc		.few_operands
+                call		div_signed
+                jc		.division_error
+                jmp		.push_result
+.mod:
+                call		pop_operands
+                jc		.few_operands
+                call		div_signed
+                jc		.division_error
+                mov		rdi, rsi		; the remainder
+                mov		rcx, rdx
+                mov		rax, r11
+
+.push_result:
+                call		push_operand
+                jmp		.next_token
+
+.end_of_input:
+                test		r15, r15
+                jz		exit			; the last line is over
+.end_of_line:
+                test		r15, r15
+                jz		.release		; an empty line
+                cmp		r15, 1
+                jne		.unused_operands
+
+                mov		rdi, [operands]
+                mov		rcx, [operands + 8]
+                cmp		qword [operands + 16], 0
+                je		.print
+                mov		al, '-'
+                call		write_char
+.print:
+                call		write_long		; write the answer
+                mov		al, 0x0a
+                call		write_char		; write the new line symbol
+
+.release:
+                mov		[heap_top], r12
+                jmp		.next_line
+
+.invalid_char:
+                call		report_invalid_char
+                jmp		.release
+
+.unused_operands:
+                mov		rsi, invalid_expression_msg
+                mov		rdx, invalid_expression_msg_size
+                call		print_string		; the line is over already
+                jmp		.release
+
+.few_operands:
+                mov		rsi, invalid_expression_msg
+                mov		rdx, invalid_expression_msg_size
+                jmp		.error
+.too_many_operands:
+                mov		rsi, too_many_operands_msg
+                mov		rdx, too_many_operands_msg_size
+                jmp		.error
+.division_error:
+                mov		rsi, rdi		; div_signed gives the message
+                mov		rdx, rcx
+.error:
+                call		print_string
+                call		skip_line
+                jmp		.release
+
+; pushes a long number to the operand stack, a zero is always positive
+;    rdi -- address of the number (long number)
+;    rcx -- length of the number in qwords
+;    rax -- sign, 1 if the number is negative
+;    r15 -- number of operands, it grows by one
+push_operand:
+                push		rbx
+
+                cmp		rcx, 1
+                jne		.store
+                cmp		qword [rdi], 0
+                jne		.store
+                xor		rax, rax
+.store:
+                lea		rbx, [r15 + 2 * r15]
+                lea		rbx, [operands + 8 * rbx]
+                mov		[rbx], rdi
+                mov		[rbx + 8], rcx
+                mov		[rbx + 16], rax
+                inc		r15
+
+                pop		rbx
+                ret
+
+; pops two operands from the operand stack, b is on the top
+;    r15 -- number of operands, it goes down by two
+; result:
+;    rdi, rcx, r10 -- address, length and sign of a
+;    rsi, rdx, r11 -- address, length and sign of b
+;    CF=1 if there are less than two operands, nothing is popped then
+pop_operands:
+                cmp		r15, 2
+                jb		.done			; CF is set already
+                sub		r15, 2
+                lea		rax, [r15 + 2 * r15]
+                lea		rax, [operands + 8 * rax]
+                mov		rdi, [rax]
+                mov		rcx, [rax + 8]
+                mov		r10, [rax + 16]
+                mov		rsi, [rax + 24]
+                mov		rdx, [rax + 32]
+                mov		r11, [rax + 40]
+                clc
+.done:
+                ret
+
+; allocates a copy of a long number with room for more qwords
+;    rdi -- address of the number (long number)
+;    rcx -- length of the number in qwords
+;    rax -- the number of qwords to allocate, at least rcx
+; result:
+;    rdi -- address of the copy
+copy_to_new:
+                push		rsi
+                push		rcx
+
+                mov		rsi, rdi
+                mov		rcx, rax
+                call		alloc_qwords
+                mov		rdi, rax
+                pop		rcx
+                call		copy_long
+
+                pop		rsi
+                ret
+
+; adds two signed long numbers
+;    rdi, rcx, r10 -- address, length and sign of a
+;    rsi, rdx, r11 -- address, length and sign of b
+; result:
+;    rdi, rcx, rax -- address, length and sign of a + b, it is allocated by alloc_qwords
+add_signed:
+                cmp		r10, r11
+                jne		.subtract
+
+                cmp		rcx, rdx
+                jae		.add
+                xchg		rdi, rsi		; the longer one goes first
+                xchg		rcx, rdx
+.add:
+                lea		rax, [rcx + 1]
+                call		copy_to_new
+                call		add_long_long
+                mov		[rdi + 8 * rcx], rax	; the carry
+                inc		rcx
+                call		normalize
+                mov		rax, r10
+                ret
+
+.subtract:
+                call		compare_long_long
+                cmp		rax, 0
+                jge		.ordered
+                xchg		rdi, rsi		; the larger one goes first and gives the sign
+                xchg		rcx, rdx
+                mov		r10, r11
+.ordered:
+                mov		rax, rcx
+                call		copy_to_new
+                call		sub_long_long
+                call		normalize
+                mov		rax, r10
+                ret
+
+; multiplies two signed long numbers, the same arguments as add_signed
+; result:
+;    rdi, rcx, rax -- address, length and sign of a * b, it is allocated by alloc_qwords
+mul_signed:
+                push		rcx
+                add		rcx, rdx
+                call		alloc_qwords
+                pop		rcx
+                mov		r9, rax
+                call		mul_long_long
+
+                mov		rdi, r9
+                add		rcx, rdx
+                call		normalize
+                mov		rax, r10
+                xor		rax, r11
+                ret
+
+; divides two signed long numbers rounding towards zero, the same arguments as add_signed
+; result:
+;    rdi, rcx, rax -- address, length and sign of a / b
+;    rsi, rdx, r11 -- address, length and sign of a % b, it has the sign of a
+;    both are allocated by alloc_qwords
+;    CF=1 if the division is impossible, rdi and rcx are the message then
+div_signed:
+                push		r8
+                push		r9
+
+                cmp		rdx, 1
+                jne		.nonzero
+                cmp		qword [rsi], 0
+                je		.division_by_zero
+.nonzero:
+                cmp		rcx, rdx
+                jb		.short_dividend
+
+                push		rcx
+                sub		rcx, rdx
+                inc		rcx
+                call		alloc_qwords		; the quotient
+                mov		r9, rax
+                mov		rcx, [rsp]
+                add		rcx, rdx
+                inc		rcx
+                call		alloc_qwords		; the scratch of div_long_long
+                mov		r8, rax
+                pop		rcx
+                mov		rax, rcx
+                call		copy_to_new		; the copy of a becomes the remainder
+                call		div_long_long
+
+                push		rdi
+                push		rcx
+                mov		rdi, r9
+                sub		rcx, rdx
+                inc		rcx
+                call		normalize
+                mov		r8, rcx			; the quotient is r9, r8 now
+                pop		rcx
+                pop		rdi
+                mov		rcx, rdx
+                call		normalize
+                mov		rsi, rdi
+                mov		rdx, rcx
+                mov		rdi, r9
+                mov		rcx, r8
+                jmp		.signs
+
+.short_dividend:
+                mov		rsi, rdi		; |a| < |b|, the quotient is zero and the remainder is a
+                mov		rdx, rcx
+                mov		rcx, 1
+                call		alloc_qwords
+                mov		qword [rax], 0
+                mov		rdi, rax
+
+.signs:
+                mov		rax, r10
+                xor		rax, r11
+                mov		r11, r10
+                clc
+                pop		r9
+                pop		r8
+                ret
+
+.division_by_zero:
+                mov		rdi, division_by_zero_msg
+                mov		rcx, division_by_zero_msg_size
+                stc
+                pop		r9
+                pop		r8
+                ret
+
+
+                section         .rodata
+invalid_expression_msg:
+                db		"Invalid expression", 0x0a
+invalid_expression_msg_size: equ $ - invalid_expression_msg
+too_many_operands_msg:
+                db		"Too many operands", 0x0a
+too_many_operands_msg_size: equ $ - too_many_operands_msg
+division_by_zero_msg:
+                db		"Division by zero", 0x0a
+division_by_zero_msg_size: equ $ - division_by_zero_msg
+
+                section         .bss
+operands:       resq		3 * MAX_OPERANDS
+
+; read_char, write_char, print_string and exit are buffered,
+; nasm looks for the files in the current directory, so assemble from task1
+%include "io.inc"
+%include "long.inc"
@@ -0,0 +1,94 @@
+; the long number routines as a C library, the functions are declared in limbs.h;
+; they follow the System V calling convention, a number is a pointer to qwords
+; (the lowest one first) and an explicit length; build the library from task1:
+;   nasm -f elf64 limbs.asm -o limbs.o && ar rcs liblimbs.a limbs.o
+; the code uses absolute addresses, so executables are linked with -no-pie
+
+                section         .text
+
+                global          limbs_init
+                global          limbs_add
+                global          limbs_sub
+                global          limbs_mul_1
+                global          limbs_div_1
+                global          limbs_div
+                global          limbs_compare
+                global          limbs_mul
+                global          limbs_mul_scratch_size
+
+; void limbs_init(void)
+limbs_init:
+                jmp             select_kernels
+
+; uint64_t limbs_add(uint64_t* a, size_t a_size, uint64_t const* b, size_t b_size)
+limbs_add:
+                xchg            rsi, rcx		; rcx = a_size, rsi = b_size
+                xchg            rsi, rdx		; rsi = b, rdx = b_size
+                jmp             add_long_long
+
+; uint64_t limbs_sub(uint64_t* a, size_t a_size, uint64_t const* b, size_t b_size)
+limbs_sub:
+                xchg            rsi, rcx
+                xchg            rsi, rdx
+                jmp             sub_long_long
+
+; uint64_t limbs_mul_1(uint64_t* a, size_t size, uint64_t b)
+limbs_mul_1:
+                push            rbx
+                mov             rbx, rdx
+                mov             rcx, rsi
+                call            mul_long_short
+                pop             rbx
+                ret
+
+; uint64_t limbs_div_1(uint64_t* a, size_t size, uint64_t b)
+limbs_div_1:
+                push            rbx
+                mov             rbx, rdx
+                mov             rcx, rsi
+                call            div_long_short
+                mov             rax, rdx
+                pop             rbx
+                ret
+
+; void limbs_div(uint64_t* quotient, uint64_t* a, size_t a_size,
+;                uint64_t const* b, size_t b_size, uint64_t* scratch)
+limbs_div:
+                mov             rax, rdi
+                mov             rdi, rsi
+                mov             rsi, rcx
+                mov             rcx, rdx
+                mov             rdx, r8
+                mov             r8, r9
+                mov             r9, rax
+                jmp             div_long_long
+
+; int limbs_compare(uint64_t const* a, size_t a_size, uint64_t const* b, size_t b_size)
+limbs_compare:
+                xchg            rsi, rcx
+                xchg            rsi, rdx
+                jmp             compare_long_long
+
+; void limbs_mul(uint64_t* out, uint64_t const* a, size_t a_size,
+;                uint64_t const* b, size_t b_size, uint64_t* scratch)
+limbs_mul:
+                mov             rax, rdi
+                mov             rdi, rsi
+                mov             rsi, rcx
+                mov             rcx, rdx
+                mov             rdx, r8
+                mov             r8, r9
+                mov             r9, rax
+                jmp             mul_long_long_scratch
+
+; size_t limbs_mul_scratch_size(size_t a_size, size_t b_size)
+limbs_mul_scratch_size:
+                mov             rcx, rdi
+                mov             rdx, rsi
+                jmp             mul_scratch_size
+
+                section         .note.GNU-stack noalloc noexec nowrite progbits
+
+; read_long and write_long are not exported, but they need io.inc
+%include "io.inc"
+%include "long.inc"
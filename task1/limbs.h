@@ -0,0 +1,52 @@
+#ifndef LIMBS_H
+#define LIMBS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// the long number routines of task1 (limbs.asm), a number is an array of 64-bit limbs,
+// the lowest one first, and its size; sizes are at least 1;
+// the functions do not keep any state except the kernels chosen by limbs_init
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// chooses the fastest kernels the processor supports, call it once before the other functions
+// and before any threads use the library; without it the kernels which run everywhere are used
+void limbs_init(void);
+
+// a += b, b_size <= a_size, returns the carry out of a_size limbs
+uint64_t limbs_add(uint64_t* a, size_t a_size, uint64_t const* b, size_t b_size);
+
+// a -= b, b_size <= a_size, returns the borrow out of a_size limbs
+uint64_t limbs_sub(uint64_t* a, size_t a_size, uint64_t const* b, size_t b_size);
+
+// a *= b, returns the limb which does not fit into (size) limbs
+uint64_t limbs_mul_1(uint64_t* a, size_t size, uint64_t b);
+
+// a /= b, b != 0, returns the remainder
+uint64_t limbs_div_1(uint64_t* a, size_t size, uint64_t b);
+
+// quotient = a / b, a = a % b, b_size <= a_size and the highest limb of b is not zero;
+// a_size - b_size + 1 limbs of the quotient are written, the remainder takes b_size limbs of a
+// and the rest of them become zeros, (scratch) has room for a_size + b_size + 1 limbs
+void limbs_div(uint64_t* quotient, uint64_t* a, size_t a_size,
+               uint64_t const* b, size_t b_size, uint64_t* scratch);
+
+// compares a and b, returns -1, 0 or 1; the highest limbs of a and b must not be zero unless
+// the number is a single zero limb, the longer number is reported as the greater one anyway
+int limbs_compare(uint64_t const* a, size_t a_size, uint64_t const* b, size_t b_size);
+
+// out = a * b, exactly a_size + b_size limbs are written, (out) must not overlap with a and b,
+// (scratch) has room for limbs_mul_scratch_size(a_size, b_size) limbs;
+// Karatsuba is used for long numbers
+void limbs_mul(uint64_t* out, uint64_t const* a, size_t a_size,
+               uint64_t const* b, size_t b_size, uint64_t* scratch);
+size_t limbs_mul_scratch_size(size_t a_size, size_t b_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // LIMBS_H
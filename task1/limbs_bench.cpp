@@ -0,0 +1,317 @@
+// benchmark of the limbs library (limbs.asm) against the same operations written as C++ loops,
+// build it from task1:
+//   nasm -f elf64 limbs.asm -o limbs.o && ar rcs liblimbs.a limbs.o
+//   g++ -O2 -no-pie limbs_bench.cpp liblimbs.a -o limbs_bench
+//
+// every line of the output is a JSON object of one case:
+//   {"op": "mul", "limbs": 1024, "asm_ns": 2.1e+05, "cpp_ns": 1.3e+06}
+// the results of both versions are compared, the benchmark fails if they differ
+// or if the quotient q and the remainder r of div do not give q * b + r == a and r < b;
+// a case which would run longer than --budget seconds is reported as {"skipped": true}
+// and larger sizes of the same operation are not tried
+//
+// options: --min-time s (0.2)   time to repeat every case for
+//          --budget s (2)       limit of one iteration, cases above it are skipped
+//          --max-limbs n (2^16) largest operand size, sizes are powers of 4 starting from 1
+//          --op name            add, sub, mul_1, div_1, mul, div
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "limbs.h"
+
+namespace {
+    struct options {
+        double min_time = 0.2;
+        double budget = 2;
+        size_t max_limbs = 1 << 16;
+        std::string op;
+    };
+
+    typedef std::vector<uint64_t> limbs;
+    typedef unsigned __int128 uint128_t;
+
+    enum operation { ADD, SUB, MUL_1, DIV_1, MUL, DIV, OPERATIONS };
+
+    const char* const OPS[OPERATIONS] = {"add", "sub", "mul_1", "div_1", "mul", "div"};
+
+    // the short operand of mul_1 and div_1
+    const uint64_t SHORT = 0x9e3779b97f4a7c15;
+
+    // the C++ versions of the library functions
+    uint64_t add(uint64_t* a, size_t a_size, uint64_t const* b, size_t b_size)
+    {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < a_size; i++) {
+            uint128_t sum = (uint128_t) a[i] + (i < b_size ? b[i] : 0) + carry;
+            a[i] = (uint64_t) sum;
+            carry = (uint64_t) (sum >> 64);
+        }
+        return carry;
+    }
+
+    uint64_t sub(uint64_t* a, size_t a_size, uint64_t const* b, size_t b_size)
+    {
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < a_size; i++) {
+            uint128_t diff = (uint128_t) a[i] - (i < b_size ? b[i] : 0) - borrow;
+            a[i] = (uint64_t) diff;
+            borrow = (uint64_t) (diff >> 64) & 1;
+        }
+        return borrow;
+    }
+
+    uint64_t mul_1(uint64_t* a, size_t size, uint64_t b)
+    {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < size; i++) {
+            uint128_t product = (uint128_t) a[i] * b + carry;
+            a[i] = (uint64_t) product;
+            carry = (uint64_t) (product >> 64);
+        }
+        return carry;
+    }
+
+    uint64_t div_1(uint64_t* a, size_t size, uint64_t b)
+    {
+        uint64_t rem = 0;
+        for (size_t i = size; i-- > 0;) {
+            uint128_t cur = ((uint128_t) rem << 64) | a[i];
+            a[i] = (uint64_t) (cur / b);
+            rem = (uint64_t) (cur % b);
+        }
+        return rem;
+    }
+
+    void mul(uint64_t* out, uint64_t const* a, size_t a_size, uint64_t const* b, size_t b_size)
+    {
+        std::fill(out, out + a_size + b_size, 0);
+        for (size_t i = 0; i < a_size; i++) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < b_size; j++) {
+                uint128_t cur = (uint128_t) a[i] * b[j] + out[i + j] + carry;
+                out[i + j] = (uint64_t) cur;
+                carry = (uint64_t) (cur >> 64);
+            }
+            out[i + b_size] = carry;
+        }
+    }
+
+    // out[0; size) = x[0; size) << shift, shift < 64, returns the bits shifted out
+    uint64_t shl(uint64_t const* x, size_t size, int shift, uint64_t* out)
+    {
+        uint64_t carry = 0;
+        for (size_t i = 0; i < size; i++) {
+            out[i] = (x[i] << shift) | carry;
+            carry = shift ? x[i] >> (64 - shift) : 0;
+        }
+        return carry;
+    }
+
+    // the contract of limbs_div, Knuth's algorithm D
+    void div(uint64_t* quotient, uint64_t* a, size_t a_size, uint64_t const* b, size_t b_size, uint64_t* scratch)
+    {
+        size_t n = b_size;
+        if (n == 1) {
+            uint64_t rem = div_1(a, a_size, b[0]);
+            std::copy(a, a + a_size, quotient);
+            std::fill(a, a + a_size, 0);
+            a[0] = rem;
+            return;
+        }
+
+        int shift = __builtin_clzll(b[n - 1]);
+        uint64_t* u = scratch;
+        uint64_t* v = scratch + a_size + 1;
+        u[a_size] = shl(a, a_size, shift, u);
+        shl(b, n, shift, v);
+
+        for (size_t j = a_size - n + 1; j-- > 0;) {
+            uint128_t top = ((uint128_t) u[j + n] << 64) | u[j + n - 1];
+            uint128_t q = top / v[n - 1], r = top % v[n - 1];
+            while ((q >> 64) != 0 || q * v[n - 2] > ((r << 64) | u[j + n - 2])) {
+                q--;
+                r += v[n - 1];
+                if ((r >> 64) != 0)
+                    break;
+            }
+
+            uint64_t carry = 0, borrow = 0;
+            for (size_t i = 0; i < n; i++) {
+                uint128_t product = q * v[i] + carry;
+                carry = (uint64_t) (product >> 64);
+                uint128_t diff = (uint128_t) u[i + j] - (uint64_t) product - borrow;
+                u[i + j] = (uint64_t) diff;
+                borrow = (uint64_t) (diff >> 64) & 1;
+            }
+            uint128_t diff = (uint128_t) u[j + n] - carry - borrow;
+            u[j + n] = (uint64_t) diff;
+            if ((diff >> 64) != 0) {
+                q--;
+                add(u + j, n + 1, v, n);
+            }
+            quotient[j] = (uint64_t) q;
+        }
+
+        for (size_t i = 0; i < a_size; i++)
+            a[i] = i < n ? (u[i] >> shift) | (shift ? u[i + 1] << (64 - shift) : 0) : 0;
+    }
+
+    // compares numbers of the same size from the highest limb
+    int compare(uint64_t const* a, uint64_t const* b, size_t size)
+    {
+        for (size_t i = size; i-- > 0;)
+            if (a[i] != b[i])
+                return a[i] < b[i] ? -1 : 1;
+        return 0;
+    }
+
+    // (out) is the result of div: the quotient and then the a.size() limbs of a with the remainder,
+    // checks that q * b + r == a and r < b
+    bool check_div(limbs const& a, limbs const& b, limbs const& out)
+    {
+        size_t q_size = a.size() - b.size() + 1;
+        uint64_t const* r = out.data() + q_size;
+        limbs product(q_size + b.size());
+        mul(product.data(), out.data(), q_size, b.data(), b.size());
+        add(product.data(), product.size(), r, b.size());
+        return product[a.size()] == 0 && compare(product.data(), a.data(), a.size()) == 0
+               && compare(r, b.data(), b.size()) < 0;
+    }
+
+    double now()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    limbs random_limbs(std::mt19937_64& gen, size_t size)
+    {
+        limbs res(size);
+        for (size_t i = 0; i < size; i++)
+            res[i] = gen();
+        res[size - 1] |= 1;
+        return res;
+    }
+
+    // runs one case of (op) and keeps the result in (out), the returned value goes there too
+    void run_op(operation op, bool asm_version, limbs const& a, limbs const& b, limbs& out, limbs& scratch)
+    {
+        switch (op) {
+            case ADD:
+            case SUB:
+            case MUL_1:
+            case DIV_1: {
+                out.assign(a.begin(), a.end());
+                uint64_t r;
+                if (op == ADD)
+                    r = asm_version ? limbs_add(out.data(), a.size(), b.data(), b.size())
+                                    : add(out.data(), a.size(), b.data(), b.size());
+                else if (op == SUB)
+                    r = asm_version ? limbs_sub(out.data(), a.size(), b.data(), b.size())
+                                    : sub(out.data(), a.size(), b.data(), b.size());
+                else if (op == MUL_1)
+                    r = asm_version ? limbs_mul_1(out.data(), a.size(), SHORT) : mul_1(out.data(), a.size(), SHORT);
+                else
+                    r = asm_version ? limbs_div_1(out.data(), a.size(), SHORT) : div_1(out.data(), a.size(), SHORT);
+                out.push_back(r);
+                break;
+            }
+            case MUL:
+                out.resize(a.size() + b.size());
+                if (asm_version)
+                    limbs_mul(out.data(), a.data(), a.size(), b.data(), b.size(), scratch.data());
+                else
+                    mul(out.data(), a.data(), a.size(), b.data(), b.size());
+                break;
+            default: {
+                size_t q_size = a.size() - b.size() + 1;
+                out.resize(q_size);
+                out.insert(out.end(), a.begin(), a.end());
+                if (asm_version)
+                    limbs_div(out.data(), out.data() + q_size, a.size(), b.data(), b.size(), scratch.data());
+                else
+                    div(out.data(), out.data() + q_size, a.size(), b.data(), b.size(), scratch.data());
+                break;
+            }
+        }
+    }
+
+    // returns seconds per iteration
+    double measure(operation op, bool asm_version, limbs const& a, limbs const& b, limbs& out, limbs& scratch,
+                   options const& opt)
+    {
+        size_t iterations = 0;
+        double start = now(), elapsed = 0;
+        do {
+            run_op(op, asm_version, a, b, out, scratch);
+            iterations++;
+            elapsed = now() - start;
+        } while (elapsed < opt.min_time && elapsed / iterations < opt.budget);
+        return elapsed / iterations;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    limbs_init();
+
+    options opt;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--min-time"))
+            opt.min_time = std::atof(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--budget"))
+            opt.budget = std::atof(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--max-limbs"))
+            opt.max_limbs = (size_t) std::atoll(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--op"))
+            opt.op = argv[i + 1];
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    for (int i = 0; i < OPERATIONS; i++) {
+        operation op = (operation) i;
+        if (!opt.op.empty() && opt.op != OPS[op])
+            continue;
+
+        bool skip = false;
+        for (size_t size = 1; size <= opt.max_limbs; size *= 4) {
+            if (skip) {
+                std::printf("{\"op\": \"%s\", \"limbs\": %zu, \"skipped\": true}\n", OPS[op], size);
+                continue;
+            }
+
+            std::mt19937_64 gen(size);
+            limbs a = random_limbs(gen, size);
+            limbs b = random_limbs(gen, op == MUL ? size : (size + 1) / 2);
+            limbs scratch(std::max(limbs_mul_scratch_size(a.size(), b.size()), a.size() + b.size()) + 1);
+            limbs asm_out, cpp_out;
+
+            double asm_time = measure(op, true, a, b, asm_out, scratch, opt);
+            double cpp_time = measure(op, false, a, b, cpp_out, scratch, opt);
+            if (asm_out != cpp_out) {
+                std::fprintf(stderr, "%s of %zu limbs: the results differ\n", OPS[op], size);
+                return 1;
+            }
+            if (op == DIV && !check_div(a, b, asm_out)) {
+                std::fprintf(stderr, "div of %zu limbs: q * b + r != a or r >= b\n", size);
+                return 1;
+            }
+
+            std::printf("{\"op\": \"%s\", \"limbs\": %zu, \"asm_ns\": %.6g, \"cpp_ns\": %.6g}\n",
+                        OPS[op], size, asm_time * 1e9, cpp_time * 1e9);
+            std::fflush(stdout);
+
+            // the next size takes at least 4 times longer, 16 times for the quadratic C++ mul and division
+            skip = std::max(asm_time, cpp_time) * (op == MUL || op == DIV ? 16 : 4) > opt.budget;
+        }
+    }
+    return 0;
+}
@@ -3,347 +3,46 @@
                 global          _start
                 
 _start:
-		sub             rsp, 2 * 128 * 8	; allocate memory for 2 long numbers
-                lea             rdi, [rsp + 128 * 8]	; move rdi to the beginning of the block for the first number
-                mov             rcx, 128		; max length of input numbers in qwords
+; pairs of numbers are read until the input is over, every difference goes to its own line
+.next_pair:
+                xor		rcx, rcx
+                call		alloc_qwords
+                mov		r12, rax		; everything allocated for the pair is freed at once
+
                 call            read_long		; read first number
-                mov             rdi, rsp		; move rdi to the beginning of the block for the second number
+                sbb		r8, r8			; r8 != 0 if the pair is invalid
+                mov		r13, rdi
+                mov		r14, rcx
                 call            read_long		; read second number
+                sbb		rax, rax
+                or		r8, rax
+                jnz		.release		; the error is reported already
+
                 mov		rsi, rdi		; rsi is now the second input number
-                lea             rdi, [rsp + 128 * 8]	; rdi is now the first input number
+                mov		rdx, rcx
+                mov		rdi, r13		; rdi is now the first input number
+                mov		rcx, r14
+                call		compare_long_long
+                cmp		rax, 0
+                jge		.subtract
+                xchg		rdi, rsi		; the difference is negative, subtract the other way round
+                xchg		rcx, rdx
+                mov		al, '-'
+                call		write_char
+.subtract:
                 call            sub_long_long		; do the subtraction
 
+                call		normalize
                 call            write_long		; write the answer
 
                 mov             al, 0x0a
                 call            write_char		; write the new line symbol
 
-                jmp             exit
-
-; subtracts two long numbers
-;     rdi -- address of minuend (long number)
-;     rsi -- address of subtrahend (long number)
-;     rcx -- length of long numbers in qwords
-; result:
-;     residual is written to rdi
-sub_long_long:
-                push            rdi
-                push            rsi
-                push            rcx
-
-                clc
-.loop:
-                mov             rax, [rdi]		; put a piece of rdi to rax
-                sbb             rax, [rsi]		; subtract a piece of rsi from rax, answer is in rax
-                lea             rsi, [rsi + 8]		; move rsi to the beginning of the unused part
-                mov		[rdi], rax		; write new piece of the answer to the used part of rdi
-                lea             rdi, [rdi + 8]		; move rdi to the beginning of the unused part
-                
-                dec             rcx			; recalc loop counter
-                jnz             .loop			; go to next circle
-
-                pop             rcx
-                pop             rsi
-                pop             rdi
-                ret
-
-; adds 64-bit number to long number
-;    rdi -- address of summand #1 (long number)
-;    rax -- summand #2 (64-bit unsigned)
-;    rcx -- length of long number in qwords
-; result:
-;    sum is written to rdi
-add_long_short:
-                push            rdi
-                push            rcx
-                push            rdx
-
-                xor             rdx,rdx
-.loop:
-                add             [rdi], rax
-                adc             rdx, 0
-                mov             rax, rdx
-                xor             rdx, rdx
-                add             rdi, 8
-                dec             rcx
-                jnz             .loop
-
-                pop             rdx
-                pop             rcx
-                pop             rdi
-                ret
-
-; adds two long numbers
-;    rdi -- address of summand #1 (long number)
-;    rsi -- address of summand #2 (long number)
-;    rcx -- length of long numbers in qwords
-; result:
-;    sum is written to rdi
-add_long_long:
-                push            rdi
-                push            rsi
-                push            rcx
-
-                clc
-.loop:
-                mov             rax, [rsi]
-                lea             rsi, [rsi + 8]
-                adc             [rdi], rax
-                lea             rdi, [rdi + 8]
-                dec             rcx
-                jnz             .loop
-
-                pop             rcx
-                pop             rsi
-                pop             rdi
-                ret
-
-; multiplies long number by a short
-;    rdi -- address of multiplier #1 (long number)
-;    rbx -- multiplier #2 (64-bit unsigned)
-;    rcx -- length of long number in qwords
-; result:
-;    product is written to rdi
-mul_long_short:
-                push            rax
-                push            rdi
-                push            rcx
-		;push		rsi
-                
-                xor             rsi, rsi
-.loop:
-                mov             rax, [rdi]
-                mul             rbx
-                add             rax, rsi
-                adc             rdx, 0
-                mov             [rdi], rax
-                add             rdi, 8
-                mov             rsi, rdx
-                dec             rcx
-                jnz             .loop
-
-                ;pop		rsi
-                pop             rcx
-                pop             rdi
-                pop             rax
-                ret
-
-; multiplies two long numbers
-;     rdi -- address of multiplier #1 (long number)
-;     rsi -- address of multiplier #2 (long number)
-;     rcx -- length of long numbers in qwords
-; result:
-;     product is written to rdi
-mul_long_long:
-		ret
-
-; divides long number by a short
-;    rdi -- address of dividend (long number)
-;    rbx -- divisor (64-bit unsigned)
-;    rcx -- length of long number in qwords
-; result:
-;    quotient is written to rdi
-;    rdx -- remainder
-div_long_short:
-                push            rdi
-                push            rax
-                push            rcx
-		;push		rdx
-                
-                lea             rdi, [rdi + 8 * rcx - 8]
-                xor             rdx, rdx
-
-.loop:
-                mov             rax, [rdi]
-                div             rbx
-                mov             [rdi], rax
-                sub             rdi, 8
-                dec             rcx
-                jnz             .loop
-
-                ;pop		rdx
-                pop             rcx
-                pop             rax
-                pop             rdi
-                ret
-
-; assigns a zero to long number
-;    rdi -- argument (long number)
-;    rcx -- length of long number in qwords
-set_zero:
-                push            rax
-                push            rdi
-                push            rcx
-
-                xor             rax, rax
-                rep stosq
-
-                pop             rcx
-                pop             rdi
-                pop             rax
-                ret
-
-; checks if a long number is a zero
-;    rdi -- argument (long number)
-;    rcx -- length of long number in qwords
-; result:
-;    ZF=1 if zero
-is_zero:
-                push            rax
-                push            rdi
-                push            rcx
-
-                xor             rax, rax
-                rep scasq
-
-                pop             rcx
-                pop             rdi
-                pop             rax
-                ret
-
-; read long number from stdin
-;    rdi -- location for output (long number)
-;    rcx -- length of long number in qwords
-read_long:
-                push            rcx
-                push            rdi
-
-                call            set_zero
-.loop:
-                call            read_char
-                or              rax, rax
-                js              exit
-                cmp             rax, 0x0a
-                je              .done
-                cmp             rax, '0'
-                jb              .invalid_char
-                cmp             rax, '9'
-                ja              .invalid_char
-
-                sub             rax, '0'
-                mov             rbx, 10
-                call            mul_long_short
-                call            add_long_short
-                jmp             .loop
-
-.done:
-                pop             rdi
-                pop             rcx
-                ret
-
-.invalid_char:
-                mov             rsi, invalid_char_msg
-                mov             rdx, invalid_char_msg_size
-                call            print_string
-                call            write_char
-                mov             al, 0x0a
-                call            write_char
-
-.skip_loop:
-                call            read_char
-                or              rax, rax
-                js              exit
-                cmp             rax, 0x0a
-                je              exit
-                jmp             .skip_loop
-
-; write long number to stdout
-;    rdi -- argument (long number)
-;    rcx -- length of long number in qwords
-write_long:
-                push            rax
-                push            rcx
-
-                mov             rax, 20
-                mul             rcx
-                mov             rbp, rsp
-                sub             rsp, rax
-
-                mov             rsi, rbp
-
-.loop:
-                mov             rbx, 10
-                call            div_long_short
-                add             rdx, '0'
-                dec             rsi
-                mov             [rsi], dl
-                call            is_zero
-                jnz             .loop
-
-                mov             rdx, rbp
-                sub             rdx, rsi
-                call            print_string
-
-                mov             rsp, rbp
-                pop             rcx
-                pop             rax
-                ret
-
-; read one char from stdin
-; result:
-;    rax == -1 if error occurs
-;    rax \in [0; 255] if OK
-read_char:
-                push            rcx
-                push            rdi
-
-                sub             rsp, 1
-                xor             rax, rax
-                xor             rdi, rdi
-                mov             rsi, rsp
-                mov             rdx, 1
-                syscall
-
-                cmp             rax, 1
-                jne             .error
-                xor             rax, rax
-                mov             al, [rsp]
-                add             rsp, 1
-
-                pop             rdi
-                pop             rcx
-                ret
-.error:
-                mov             rax, -1
-                add             rsp, 1
-                pop             rdi
-                pop             rcx
-                ret
-
-; write one char to stdout, errors are ignored
-;    al -- char
-write_char:
-                sub             rsp, 1
-                mov             [rsp], al
-
-                mov             rax, 1
-                mov             rdi, 1
-                mov             rsi, rsp
-                mov             rdx, 1
-                syscall
-                add             rsp, 1
-                ret
-
-exit:
-                mov             rax, 60
-                xor             rdi, rdi
-                syscall
-
-; print string to stdout
-;    rsi -- string
-;    rdx -- size
-print_string:
-                push            rax
-
-                mov             rax, 1
-                mov             rdi, 1
-                syscall
-
-                pop             rax
-                ret
-
+.release:
+                mov		[heap_top], r12
+                jmp             .next_pair
 
-                section         .rodata
-invalid_char_msg:
-                db              "Invalid character: "
-invalid_char_msg_size: equ             $ - invalid_char_msg
+; read_char, write_char, print_string and exit are buffered,
+; nasm looks for the files in the current directory, so assemble from task1
+%include "io.inc"
+%include "long.inc"
@@ -1,88 +1,22 @@
-#ifndef BIG_INTEGER_H
-#define BIG_INTEGER_H
-
-#include <iosfwd>
-#include <string>
-#include <vector>
-
-using namespace std;
-
-struct big_integer
-{
-	big_integer();
-	big_integer(big_integer const& other);
-	big_integer(int a);
-	explicit big_integer(std::string const& str);
-	~big_integer();
-
-	big_integer& operator=(big_integer const& other);
-
-	big_integer& operator+=(big_integer const& rhs);
-	big_integer& operator-=(big_integer const& rhs);
-	big_integer& operator*=(big_integer const& rhs);
-	big_integer& operator/=(big_integer const& rhs);
-	big_integer& operator%=(big_integer const& rhs);
-
-	big_integer& operator&=(big_integer const& rhs);
-	big_integer& operator|=(big_integer const& rhs);
-	big_integer& operator^=(big_integer const& rhs);
-
-	big_integer& operator<<=(int rhs);
-	big_integer& operator>>=(int rhs);
-
-	big_integer operator+() const;
-	big_integer operator-() const;
-	big_integer operator~() const;
-
-	big_integer& operator++();
-	big_integer operator++(int);
-
-	big_integer& operator--();
-	big_integer operator--(int);
-
-	big_integer abs() const;
-
-	friend bool operator==(big_integer const& a, big_integer const& b);
-	friend bool operator!=(big_integer const& a, big_integer const& b);
-	friend bool operator<(big_integer const& a, big_integer const& b);
-	friend bool operator>(big_integer const& a, big_integer const& b);
-	friend bool operator<=(big_integer const& a, big_integer const& b);
-	friend bool operator>=(big_integer const& a, big_integer const& b);
-
-	friend std::string to_string(big_integer const& a);
-
-private:
-    big_integer convert() const;
-	big_integer add(big_integer const& rhs) const;
-	big_integer sub(big_integer const& rhs) const;
-    uint32_t div_long_short(uint32_t rhs);
-	void trim();
-
-	vector<uint32_t> number;
-	signed char sign;
-};
-
-big_integer operator+(big_integer a, big_integer const& b);
-big_integer operator-(big_integer a, big_integer const& b);
-big_integer operator*(big_integer a, big_integer const& b);
-big_integer operator/(big_integer a, big_integer const& b);
-big_integer operator%(big_integer a, big_integer const& b);
-
-big_integer operator&(big_integer a, big_integer const& b);
-big_integer operator|(big_integer a, big_integer const& b);
-big_integer operator^(big_integer a, big_integer const& b);
-
-big_integer operator<<(big_integer a, int b);
-big_integer operator>>(big_integer a, int b);
-
-bool operator==(big_integer const& a, big_integer const& b);
-bool operator!=(big_integer const& a, big_integer const& b);
-bool operator<(big_integer const& a, big_integer const& b);
-bool operator>(big_integer const& a, big_integer const& b);
-bool operator<=(big_integer const& a, big_integer const& b);
-bool operator>=(big_integer const& a, big_integer const& b);
-
-std::string to_string(big_integer const& a);
-std::ostream& operator<<(std::ostream& s, big_integer const& a);
-
-#endif // BIG_INTEGER_H
\ No newline at end of file
+#ifndef TASK2_BIG_INTEGER_H
+#define TASK2_BIG_INTEGER_H
+
+// task2 is big_integer over plain std::vector storage, it shares the implementation with task3
+// (see ../task3/big_integer.h); BIGINT_STORAGE must be the same in every translation unit,
+// so build the whole program with it, from task2:
+//   g++ -O2 -std=c++14 -DBIGINT_STORAGE=vector_container main.cpp ../task3/big_integer.cpp
+//       ../task3/big_integer_view.cpp ../task3/limb_kernels.cpp ../task3/limb_allocator.cpp
+//       ../task3/bigint_arena.cpp ../task3/container_v1.cpp
+#ifndef BIGINT_STORAGE
+#define BIGINT_STORAGE vector_container
+#endif
+
+#include <type_traits>
+#include "../task3/big_integer.h"
+
+static_assert(std::is_same<big_integer, basic_big_integer<vector_container> >::value,
+              "big_integer: task2 needs BIGINT_STORAGE to be vector_container");
+
+typedef basic_big_integer<vector_container> task2_big_integer;
+
+#endif // TASK2_BIG_INTEGER_H
@@ -0,0 +1,136 @@
+#include "big_accumulator.h"
+
+const int32_t POWER = 30, BASE = (1 << POWER);
+
+// every addition moves a partial sum by less than BASE,
+// so after this many additions a sum is still far from 2^63
+const uint64_t MAX_PENDING = (uint64_t) 1 << 32;
+
+big_accumulator::big_accumulator() :
+        pending(0)
+{}
+
+big_accumulator &big_accumulator::operator+=(big_integer_view const &value)
+{
+    add_limbs(value, value.sign < 0);
+    return *this;
+}
+
+big_accumulator &big_accumulator::operator-=(big_integer_view const &value)
+{
+    add_limbs(value, value.sign > 0);
+    return *this;
+}
+
+big_accumulator &big_accumulator::merge(big_accumulator const &other)
+{
+    count(other.pending);
+    if (sums.size() < other.sums.size())
+        sums.resize(other.sums.size(), 0);
+
+    for (size_t i = 0; i < other.sums.size(); i++)
+        sums[i] += other.sums[i];
+
+    return *this;
+}
+
+template <typename Storage>
+basic_big_integer<Storage> big_accumulator::result() const
+{
+    big_accumulator copy(*this);
+    copy.normalize();
+
+    basic_big_integer<Storage> result;
+    if (copy.sums.empty())
+        return result;
+
+    if (copy.sums.back() < 0) {
+        // the top partial sum is the only signed one, so negate everything and carry once more
+        for (size_t i = 0; i < copy.sums.size(); i++)
+            copy.sums[i] = -copy.sums[i];
+        copy.normalize();
+        result.sign = -1;
+    }
+
+    size_t size = copy.sums.size();
+    while (size > 1 && copy.sums[size - 1] == 0)
+        size--;
+
+    result.number.resize(size);
+    for (size_t i = 0; i < size; i++)
+        result.number[i] = (uint32_t) copy.sums[i];
+
+    return result;
+}
+
+template basic_big_integer<container> big_accumulator::result<container>() const;
+template basic_big_integer<shared_container> big_accumulator::result<shared_container>() const;
+template basic_big_integer<vector_container> big_accumulator::result<vector_container>() const;
+template basic_big_integer<sbo_container> big_accumulator::result<sbo_container>() const;
+
+void big_accumulator::clear()
+{
+    sums.clear();
+    pending = 0;
+}
+
+// adds a native integer split into limbs, (value) is the absolute value
+void big_accumulator::add_native(bool negative, uint64_t value)
+{
+    count(1);
+    for (size_t i = 0; value != 0; i++, value >>= POWER) {
+        if (i == sums.size())
+            sums.push_back(0);
+
+        int64_t limb = (int64_t) (value & (BASE - 1));
+        sums[i] += negative ? -limb : limb;
+    }
+}
+
+// adds limbs of (value) to partial sums, (negative) tells whether to subtract them
+void big_accumulator::add_limbs(big_integer_view const &value, bool negative)
+{
+    count(1);
+    size_t size = value.size;
+    if (sums.size() < size)
+        sums.resize(size, 0);
+
+    if (negative) {
+        for (size_t i = 0; i < size; i++)
+            sums[i] -= value.data[i];
+    } else {
+        for (size_t i = 0; i < size; i++)
+            sums[i] += value.data[i];
+    }
+}
+
+// accounts (additions) more summands, carries first if the partial sums could overflow
+void big_accumulator::count(uint64_t additions)
+{
+    if (pending + additions > MAX_PENDING)
+        normalize();
+    pending += additions;
+}
+
+// propagates carries: afterwards every partial sum is in [0; BASE),
+// except for the top one, which is in (-BASE; BASE) and holds the sign
+void big_accumulator::normalize()
+{
+    pending = 0;
+    if (sums.empty())
+        return;
+
+    int64_t carry = 0;
+    for (size_t i = 0; i + 1 < sums.size(); i++) {
+        int64_t temp = sums[i] + carry;
+        sums[i] = temp & (BASE - 1);
+        carry = temp >> POWER;          // arithmetic shift, rounds towards minus infinity
+    }
+    sums.back() += carry;
+
+    while (sums.back() >= BASE || sums.back() <= -BASE) {
+        int64_t temp = sums.back();
+        sums.back() = temp & (BASE - 1);
+        sums.push_back(temp >> POWER);
+    }
+}
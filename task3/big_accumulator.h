@@ -0,0 +1,59 @@
+#ifndef BIG_ACCUMULATOR_H
+#define BIG_ACCUMULATOR_H
+
+#include <cstdint>
+#include <vector>
+#include <type_traits>
+#include "big_integer.h"
+
+// sums many numbers without propagating carries on every addition:
+// every limb position keeps its own 64-bit partial sum,
+// carries are resolved only by result() (or when a partial sum could overflow)
+struct big_accumulator {
+    big_accumulator();
+
+    // any big_integer storage converts to a view
+    big_accumulator& operator+=(big_integer_view const& value);
+    big_accumulator& operator-=(big_integer_view const& value);
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, big_accumulator&>::type operator+=(T value)
+    {
+        add_native(value < 0, magnitude(value));
+        return *this;
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_integral<T>::value, big_accumulator&>::type operator-=(T value)
+    {
+        add_native(!(value < 0), magnitude(value));
+        return *this;
+    }
+
+    // adds partial sums of (other), so per-thread accumulators can be reduced
+    big_accumulator& merge(big_accumulator const& other);
+
+    // the storage is a template argument, so the symbol differs for every storage
+    // and does not depend on BIGINT_STORAGE of the translation unit
+    template <typename Storage = BIGINT_STORAGE>
+    basic_big_integer<Storage> result() const;
+    void clear();
+
+private:
+    std::vector<int64_t> sums;
+    uint64_t pending;   // additions since the last normalization
+
+    template <typename T>
+    static uint64_t magnitude(T value)
+    {
+        // unsigned negation also covers the minimal value of T
+        return value < 0 ? -(uint64_t) value : (uint64_t) value;
+    }
+
+    void add_native(bool negative, uint64_t value);
+    void add_limbs(big_integer_view const& value, bool negative);
+    void count(uint64_t additions);
+    void normalize();
+};
+
+#endif // BIG_ACCUMULATOR_H
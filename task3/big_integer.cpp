@@ -1,4 +1,6 @@
 #include "big_integer.h"
+#include "limb_kernels.h"
+#include "bigint_stats.h"
 
 #include <cstring>
 #include <algorithm>
@@ -6,17 +8,20 @@
 
 const int32_t POWER = 30, BASE = (1 << POWER);
 
-big_integer::big_integer() :
-        number(container(1, 0)),
+template <typename Storage>
+basic_big_integer<Storage>::basic_big_integer() :
+        number(Storage(1, 0)),
         sign(1)
 {}
 
-big_integer::big_integer(big_integer const &other) :
+template <typename Storage>
+basic_big_integer<Storage>::basic_big_integer(basic_big_integer const &other) :
         number(other.number),
         sign(other.sign)
 {}
 
-big_integer::big_integer(int a)
+template <typename Storage>
+basic_big_integer<Storage>::basic_big_integer(int a)
 {
     uint32_t value;
 
@@ -31,7 +36,7 @@ big_integer::big_integer(int a)
         this->sign = 1;
     }
 
-    this->number = container(0);
+    this->number = Storage(0);
     if (value >= BASE) {
         this->number.push_back(value % BASE);
         this->number.push_back(value >> POWER);
@@ -39,7 +44,8 @@ big_integer::big_integer(int a)
         this->number.push_back(value);
 }
 
-big_integer::big_integer(std::string const &str) :
+template <typename Storage>
+basic_big_integer<Storage>::basic_big_integer(std::string const &str) :
         number(1, 0),
         sign(1)
 {
@@ -51,32 +57,54 @@ big_integer::big_integer(std::string const &str) :
         s++;
     }
 
-    for (size_t i = s; i < str.length(); i++) {
-        *this *= 10;
-        *this += str[i] - '0';
+    // 9 digits at a time: number = number * 10^count + digits
+    for (size_t i = s; i < str.length(); ) {
+        uint32_t digits = 0, scale = 1;
+        for (size_t end = std::min(i + 9, str.length()); i < end; i++) {
+            digits = digits * 10 + (uint32_t) (str[i] - '0');
+            scale *= 10;
+        }
+        uint32_t carry = mul_1_limbs(this->number, scale, digits, this->number.data());
+        if (carry != 0)
+            this->number.push_back(carry);
     }
 
     if (neg)
         this->sign = -1;
 }
 
-big_integer::~big_integer() {}
+template <typename Storage>
+basic_big_integer<Storage>::basic_big_integer(big_integer_view const &view) :
+        number(std::max(view.size, (size_t) 1), 0),
+        sign(view.sign)
+{
+    for (size_t i = 0; i < view.size; i++)
+        this->number[i] = view.data[i];
+}
+
+template <typename Storage>
+basic_big_integer<Storage>::~basic_big_integer() {}
 
-big_integer &big_integer::operator=(big_integer const &other)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator=(basic_big_integer const &other)
 {
+    this->invalidate_hash();
     this->number = other.number;
     this->sign = other.sign;
 
     return *this;
 }
 
-big_integer &big_integer::operator+=(big_integer const &rhs)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator+=(basic_big_integer const &rhs)
 {
+    BIGINT_STAT(operands(bigint_stats::ADD, this->number.size(), rhs.number.size()));
+    this->invalidate_hash();
     if (this->sign == rhs.sign) {
         *this = this->add(rhs);
         return *this;
     } else {
-        if (this->abs() > rhs.abs()) {
+        if (compare_limbs(*this, rhs) > 0) {
             *this = this->sub(rhs);
             return *this;
         } else {
@@ -87,13 +115,16 @@ big_integer &big_integer::operator+=(big_integer const &rhs)
     }
 }
 
-big_integer &big_integer::operator-=(big_integer const &rhs)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator-=(basic_big_integer const &rhs)
 {
+    BIGINT_STAT(operands(bigint_stats::SUB, this->number.size(), rhs.number.size()));
+    this->invalidate_hash();
     if (this->sign != rhs.sign) {
         *this = this->add(rhs);
         return *this;
     } else {
-        if (this->abs() > rhs.abs()) {
+        if (compare_limbs(*this, rhs) > 0) {
             *this = this->sub(rhs);
             return *this;
         } else {
@@ -104,518 +135,305 @@ big_integer &big_integer::operator-=(big_integer const &rhs)
     }
 }
 
-big_integer &big_integer::operator*=(big_integer const &rhs)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator*=(basic_big_integer const &rhs)
 {
-    big_integer copy(*this);
-    this->number.assign(this->number.size() + rhs.number.size() + 1, 0);
-
-    for (size_t i = 0; i < copy.number.size(); i++) {
-        int64_t temp = 0;
-        for (size_t j = 0; j < rhs.number.size(); j++) {
-            temp += (int64_t) rhs.number[j] * copy.number[i] + this->number[i + j];
-            this->number[i + j] = (uint32_t) (temp & (BASE - 1));
-
-            temp >>= POWER;
-        }
-        this->number[i + rhs.number.size()] += temp;
-    }
+    BIGINT_STAT(operands(bigint_stats::MUL, this->number.size(), rhs.number.size()));
+    this->invalidate_hash();
+    Storage product(this->number.size() + rhs.number.size());
+    Storage scratch(mul_scratch_size(std::max(this->number.size(), rhs.number.size())));
+    mul_limbs(*this, rhs, product.data(), scratch.data());
 
+    this->number = product;
     this->trim();
     this->sign *= rhs.sign;
 
     return *this;
 }
 
-big_integer &big_integer::operator/=(big_integer const &rhs)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator/=(basic_big_integer const &rhs)
 {
-    if (this->abs() < rhs.abs()) {
-        *this = 0;
-        return *this;
-    }
-
-    if (rhs.number.size() == 1) {
-        this->div_long_short(rhs.number[0]);
-        this->sign *= rhs.sign;
-        return *this;
-    }
-
-    big_integer divider = rhs.abs(), carry;
-    for (int i = (int) (this->number.size() - 1); i >= 0; i--) {
-        carry = (carry << POWER) + this->number[i];
-
-        if (carry >= rhs) {
-            int l = 0, r = BASE, m = (l + r) / 2;
-            while (r - l > 1) {
-                big_integer temp = m * divider;
-                if (temp <= carry)
-                    l = m;
-                else
-                    r = m;
-
-                m = (l + r) / 2;
-            }
-
-            this->number[i] = (uint32_t) l;
-            carry -= l * divider;
-        } else if ((uint32_t) i == this->number.size() - 1)
-            this->number.pop_back();
-    }
-
-    this->trim();
-    this->sign *= rhs.sign;
-
-    return *this;
+    BIGINT_STAT(operands(bigint_stats::DIV, this->number.size(), rhs.number.size()));
+    return this->div_mod(rhs, false);
 }
 
-big_integer &big_integer::operator%=(big_integer const &rhs)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator%=(basic_big_integer const &rhs)
 {
-    big_integer temp(*this / rhs);
-    return (*this -= temp * rhs);
+    BIGINT_STAT(operands(bigint_stats::MOD, this->number.size(), rhs.number.size()));
+    return this->div_mod(rhs, true);
 }
 
-big_integer &big_integer::operator&=(big_integer const &rhs)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator&=(basic_big_integer const &rhs)
 {
-    if (this->sign < 0) {
-        *this = this->convert();
-        if (this->number.size() < rhs.number.size())
-            for (size_t i = this->number.size(); i < rhs.number.size(); i++)
-                this->number.push_back((uint32_t) (BASE - 1));
-    }
-
-    big_integer rhscopy;
-    if (rhs.sign < 0) {
-        rhscopy = rhs.convert();
-        if (this->number.size() > rhscopy.number.size())
-            for (size_t i = rhscopy.number.size(); i < this->number.size(); i++)
-                rhscopy.number.push_back((uint32_t) (BASE - 1));
-    } else
-        rhscopy = rhs;
-
-    unsigned size = (uint32_t) std::min(this->number.size(), rhscopy.number.size());
-    for (size_t i = 0; i < size; i++)
-        this->number[i] &= rhscopy.number[i];
-
-    if (this->sign > 0)
-        this->number.resize(size);
-    else
-        *this = this->convert();
-
-    return *this;
+    BIGINT_STAT(operands(bigint_stats::AND, this->number.size(), rhs.number.size()));
+    return this->bitwise(rhs, and_limbs);
 }
 
-big_integer &big_integer::operator|=(big_integer const &rhs)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator|=(basic_big_integer const &rhs)
 {
-    unsigned size = (uint32_t) std::min(this->number.size(), rhs.number.size());
-
-    if (this->sign < 0)
-        *this = this->convert();
-
-    big_integer rhscopy;
-    if (rhs.sign < 0)
-        rhscopy = rhs.convert();
-    else
-        rhscopy = rhs;
-
-    if (this->number.size() < rhscopy.number.size()) {
-        this->number.resize(rhscopy.number.size());
-        if (this->sign > 0) {
-            this->number.copy(size, rhscopy.number, size, rhscopy.number.size());
-        }
-    }
-
-    for (size_t i = 0; i < size; i++)
-        this->number[i] |= rhscopy.number[i];
-
-    if (this->sign < 0 || rhscopy.sign < 0) {
-        *this = this->convert();
-        this->sign = -1;
-    }
-
-    return *this;
+    BIGINT_STAT(operands(bigint_stats::OR, this->number.size(), rhs.number.size()));
+    return this->bitwise(rhs, or_limbs);
 }
 
-big_integer &big_integer::operator^=(big_integer const &rhs)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator^=(basic_big_integer const &rhs)
 {
-    unsigned size = (uint32_t) std::min(this->number.size(), rhs.number.size());
-
-    if (this->sign < 0)
-        *this = this->convert();
-
-    big_integer rhscopy;
-    if (rhs.sign < 0)
-        rhscopy = rhs.convert();
-    else
-        rhscopy = rhs;
-
-    if (this->number.size() < rhscopy.number.size()) {
-        this->number.resize(rhscopy.number.size());
-        this->number.copy(size, rhscopy.number, size, rhscopy.number.size());
-    }
-
-    for (size_t i = 0; i < size; i++)
-        this->number[i] ^= rhscopy.number[i];
-
-    this->sign *= rhs.sign;
-
-    if (this->sign < 0)
-        *this = this->convert();
-
-    return *this;
+    BIGINT_STAT(operands(bigint_stats::XOR, this->number.size(), rhs.number.size()));
+    return this->bitwise(rhs, xor_limbs);
 }
 
-big_integer &big_integer::operator<<=(int32_t rhs)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator<<=(int32_t rhs)
 {
-    uint32_t n = (uint32_t) (rhs / (POWER)), r = (uint32_t) (rhs % POWER), size = (uint32_t) this->number.size();
-
-    this->number.resize(this->number.size() + n + 1);
-
-    if (n) {
-        for (int32_t i = size - 1; i >= 0; i--) {
-            this->number[i + n] = this->number[i];
-            this->number[i] = 0;
-        }
-    }
-
-    if (r) {
-        uint32_t last = (uint32_t) (this->number.size() - 2);
-        this->number.back() = (this->number[this->number.size() - 2] >> (POWER - r));
-
-        for (int32_t i = last; i > 0; i--) {
-            this->number[i] <<= r;
-            this->number[i] &= BASE - 1;
-
-            int32_t temp = (this->number[i - 1] >> (POWER - r));
-            this->number[i] += temp;
-            this->number[i - 1] -= temp << (POWER - r);
-        }
-
-        this->number[0] <<= r;
-        this->number[0] &= BASE - 1;
-    }
+    BIGINT_STAT(operand(bigint_stats::SHL, this->number.size()));
+    this->invalidate_hash();
+    Storage shifted(this->number.size() + rhs / POWER + 1);
+    shifted.resize(shl_limbs(*this, (size_t) rhs, shifted.data()));
 
-    this->trim();
+    this->number = shifted;
     return *this;
 }
 
-big_integer &big_integer::operator>>=(int32_t rhs)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator>>=(int32_t rhs)
 {
-    uint32_t n = (uint32_t) (rhs / (POWER)), r = (uint32_t) (rhs % POWER), size = (uint32_t) this->number.size();
-
-    if (n) {
-        for (size_t i = 0; i < size - n; i++) {
-            this->number[i] = this->number[i + n];
-            this->number[i + n] = 0;
-        }
-    }
-
-    if (this->sign < 0) {
-        *this = this->convert();
-        this->number.push_back((uint32_t) (BASE - 1));
-    } else {
-        this->number.resize(size - n);
-        this->number.push_back(0);
-    }
+    BIGINT_STAT(operand(bigint_stats::SHR, this->number.size()));
+    this->invalidate_hash();
+    // negative numbers are rounded down, so their absolute value is rounded up
+    bool round_up = this->sign < 0 && !low_bits_zero(*this, (size_t) rhs);
 
-    if (r) {
-        for (size_t i = 0; i < this->number.size() - 1; i++) {
-            this->number[i] >>= r;
-            this->number[i] += (this->number[i + 1] << (POWER - r)) & (BASE - 1);
-        }
-    }
-
-    if (this->sign < 0)
-        *this = this->convert();
+    Storage shifted(this->number.size());
+    shifted.resize(shr_limbs(*this, (size_t) rhs, shifted.data()));
 
-    this->trim();
+    this->number = shifted;
+    if (round_up)
+        *this -= 1;
     return *this;
 }
 
-big_integer big_integer::operator+() const
+template <typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::operator+() const
 {
     return *this;
 }
 
-big_integer big_integer::operator-() const
+template <typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::operator-() const
 {
-    big_integer copy = *this;
+    basic_big_integer copy = *this;
     copy.sign *= -1;
     return copy;
 }
 
-big_integer big_integer::operator~() const
+template <typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::operator~() const
 {
     return -(*this) - 1;
 }
 
-big_integer &big_integer::operator++()
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator++()
 {
     return (*this += 1);
 }
 
-big_integer big_integer::operator++(int32_t a)
+template <typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::operator++(int32_t a)
 {
-    big_integer num = a;
+    basic_big_integer num = a;
     return num++;
 }
 
-big_integer &big_integer::operator--()
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::operator--()
 {
     return (*this -= 1);
 }
 
-big_integer big_integer::operator--(int32_t a)
+template <typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::operator--(int32_t a)
 {
-    big_integer num = a;
+    basic_big_integer num = a;
     return num--;
 }
 
-big_integer operator+(big_integer a, big_integer const &b)
-{
-    return big_integer(a) += b;
-}
-
-big_integer operator-(big_integer a, big_integer const &b)
-{
-    return big_integer(a) -= b;
-}
-
-big_integer operator*(big_integer a, big_integer const &b)
-{
-    return big_integer(a) *= b;
-}
-
-big_integer operator/(big_integer a, big_integer const &b)
-{
-    return big_integer(a) /= b;
-}
-
-big_integer operator%(big_integer a, big_integer const &b)
-{
-    return big_integer(a) %= b;
-}
-
-big_integer operator&(big_integer a, big_integer const &b)
+// compares (a) and (b), returns -1, 0 or 1
+template <typename Storage>
+int basic_big_integer<Storage>::compare(basic_big_integer const &a, basic_big_integer const &b)
 {
-    return big_integer(a) &= b;
-}
-
-big_integer operator|(big_integer a, big_integer const &b)
-{
-    return big_integer(a) |= b;
-}
-
-big_integer operator^(big_integer a, big_integer const &b)
-{
-    return big_integer(a) ^= b;
-}
+    BIGINT_STAT(operands(bigint_stats::CMP, a.number.size(), b.number.size()));
+    big_integer_view x(a), y(b);    // zero is positive in views
+    if (x.sign != y.sign)
+        return x.sign < y.sign ? -1 : 1;
 
-big_integer operator<<(big_integer a, int32_t b)
-{
-    return big_integer(a) <<= b;
-}
-
-big_integer operator>>(big_integer a, int32_t b)
-{
-    return big_integer(a) >>= b;
-}
-
-bool operator==(big_integer const &a, big_integer const &b)
-{
-    if ((a.number.size() == 1) && (a.number[0] == 0) && (b.number.size() == 1) && (b.number[0] == 0))
-        return true;
-
-    if (a.sign != b.sign)
-        return false;
-    else {
-        if (a.number.size() != b.number.size())
-            return false;
-        else {
-            int32_t i = (int) (a.number.size() - 1);
-            while (i >= 0 && a.number[i] == b.number[i])
-                i--;
-
-            return i < 0;
-        }
-    }
-}
-
-bool operator!=(big_integer const &a, big_integer const &b)
-{
-    return !(a == b);
-}
-
-bool operator<(big_integer const &a, big_integer const &b)
-{
-    if ((a == 0) && (b == 0))
-        return false;
-
-    if (a.sign != b.sign)
-        return a.sign < 0;
-    else {
-        if (a.number.size() < b.number.size())
-            return a.sign > 0;
-        else if (a.number.size() > b.number.size())
-            return a.sign < 0;
-        else {
-            int32_t i = (int) (a.number.size() - 1);
-            while (i >= 0 && a.number[i] == b.number[i])
-                i--;
-
-            if (i < 0)
-                return false;
-            else
-              return a.number[i] < b.number[i];
-        }
-    }
-}
-
-bool operator>(big_integer const &a, big_integer const &b)
-{
-    return b < a;
-}
-
-bool operator<=(big_integer const &a, big_integer const &b)
-{
-    return !(a > b);
-}
-
-bool operator>=(big_integer const &a, big_integer const &b)
-{
-    return b <= a;
+    int cmp = compare_limbs(x, y);
+    return x.sign > 0 ? cmp : -cmp;
 }
 
-std::string to_string(big_integer const &a)
+template <typename Storage>
+std::string basic_big_integer<Storage>::to_decimal() const
 {
+    basic_big_integer const &a = *this;
     if (a == 0)
         return "0";
 
-    string result = "";
-
-    big_integer ten = (int) 1e8, copy = a;
-    while (copy != 0) {
-        string mod = to_string((copy % ten).number[0]);
-        copy /= ten;
-
-        while ((copy != 0) && (mod.length() < 8))
-            mod = "0" + mod;
-        result = mod + result;
+    // the digits are written from the lowest ones, 9 of them per division of the rest
+    string result;
+    result.reserve(a.number.size() * 10 + 1);
+
+    Storage rest(a.number.size());
+    uint32_t *data = rest.data();
+    limb_span left = a;
+    while (left.size > 0) {
+        uint32_t digits = div_1_limbs(left, 1000000000, data);
+        size_t size = left.size;
+        while (size > 0 && data[size - 1] == 0)
+            size--;
+        left = limb_span(data, size);
+
+        for (int i = 0; i < 9; i++) {
+            result += (char) ('0' + digits % 10);
+            digits /= 10;
+        }
     }
 
+    while (result.back() == '0')
+        result.pop_back();
     if (a.sign < 0)
-        result = "-" + result;
+        result += '-';
+    std::reverse(result.begin(), result.end());
 
     return result;
 }
 
-std::ostream &operator<<(std::ostream &s, big_integer const &a)
-{
-    return s << to_string(a);
-}
-
 // returns the absolute value of (this)
-big_integer big_integer::abs() const
+template <typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::abs() const
 {
-    big_integer copy = *this;
+    basic_big_integer copy = *this;
     copy.sign = 1;
     return copy;
 }
 
 // adds two numbers as if they have the same sign
-big_integer big_integer::add(big_integer const &rhs) const
+template <typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::add(basic_big_integer const &rhs) const
 {
-    big_integer result;
+    basic_big_integer result;
     result.sign = this->sign;
 
-    size_t size = std::max(this->number.size(), rhs.number.size());
-    result.number.reserve(size + 1);
-    result.number.resize(size);
-
-    int64_t temp = 0;
-    for (size_t i = 0; i < size; i++) {
-        temp += (i < this->number.size()) ? this->number[i] : 0;
-        temp += (i < rhs.number.size()) ? rhs.number[i] : 0;
-
-        result.number[i] = (uint32_t) (temp & (BASE - 1));
-        temp >>= POWER;
-    }
-
-    if (temp != 0)
-        result.number.push_back((uint32_t) (temp & (BASE - 1)));
+    result.number.resize(std::max(this->number.size(), rhs.number.size()) + 1);
+    result.number.resize(add_limbs(*this, rhs, result.number.data()));
 
     return result;
 }
 
 // subtracts two numbers as if they have the same sign and (this) is greater than (rhs)
-big_integer big_integer::sub(big_integer const &rhs) const
+template <typename Storage>
+basic_big_integer<Storage> basic_big_integer<Storage>::sub(basic_big_integer const &rhs) const
 {
-    big_integer result;
+    basic_big_integer result;
     result.sign = this->sign;
 
-    size_t size = std::max(this->number.size(), rhs.number.size());
-    result.number.reserve(size + 1);
-    result.number.resize(size);
-
-    int64_t temp = 0;
-    bool borrow = 0;
-    for (size_t i = 0; i < size; i++) {
-        temp += (i < this->number.size()) ? this->number[i] : 0;
-        temp -= borrow;
-        temp -= (i < rhs.number.size()) ? rhs.number[i] : 0;
+    result.number.resize(this->number.size());
+    result.number.resize(sub_limbs(*this, rhs, result.number.data()));
 
-        borrow = 0;
+    return result;
+}
 
-        if (temp < 0) {
-            temp += BASE;
-            borrow++;
-        }
+// writes (size) >= number.size() lowest limbs of the two's complement representation of (this),
+// the higher ones are all zeros or all ones like the sign
+template <typename Storage>
+void basic_big_integer<Storage>::to_twos(size_t size, uint32_t *out) const
+{
+    std::copy_n(this->number.data(), this->number.size(), out);
+    std::fill(out + this->number.size(), out + size, 0);
 
-        result.number[i] = (uint32_t) (temp & (BASE - 1));
-        temp >>= POWER;
+    if (big_integer_view(*this).sign < 0) {    // -a = ~(a - 1)
+        uint32_t one = 1;
+        sub_limbs(limb_span(out, size), limb_span(&one, 1), out);
+        not_limbs(limb_span(out, size), out);
     }
-
-    if (temp != 0)
-        result.number.push_back((uint32_t) (temp & (BASE - 1)));
-
-    result.trim();
-    return result;
 }
 
-// converts (this) to the two's complement representation
-// the (sign) remains
-big_integer big_integer::convert() const
+// applies a limb by limb operation (op) to the two's complement representations of (this) and (rhs)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::bitwise(basic_big_integer const &rhs, void (*op)(limb_span, limb_span, uint32_t*))
 {
-    big_integer copy;
-    copy.sign = this->sign;
-    copy.number.resize(this->number.size());
-
-    copy.number[0] = (-this->number[0]) & (BASE - 1);
-    for (size_t i = 1; i < this->number.size(); i++)
-        copy.number[i] = (~this->number[i]) & (BASE - 1);
+    this->invalidate_hash();
+    size_t size = std::max(this->number.size(), rhs.number.size());
+    Storage x(size + 1), y(size);
+    this->to_twos(size, x.data());
+    rhs.to_twos(size, y.data());
+
+    // the same operation on the infinite high limbs gives the sign of the result
+    uint32_t high_x = big_integer_view(*this).sign < 0 ? BASE - 1 : 0;
+    uint32_t high_y = big_integer_view(rhs).sign < 0 ? BASE - 1 : 0;
+    uint32_t high;
+    op(limb_span(&high_x, 1), limb_span(&high_y, 1), &high);
+    op(limb_span(x.data(), size), limb_span(y.data(), size), x.data());
+
+    this->sign = 1;
+    if (high != 0) {                                // the result is negative, its absolute value is ~x + 1
+        uint32_t one = 1;
+        not_limbs(limb_span(x.data(), size), x.data());
+        x.resize(add_limbs(limb_span(x.data(), size), limb_span(&one, 1), x.data()));
+        this->sign = -1;
+    }
 
-    return copy;
+    this->number = x;
+    this->trim();
+    return *this;
 }
 
-// divides (this) by (rhs)
-// returns remainder
-// does not change sign
-uint32_t big_integer::div_long_short(uint32_t rhs)
+// replaces (this) by the quotient of (this) and (rhs) rounded towards zero,
+// or by the remainder if (remainder) is true, it keeps the sign of (this)
+template <typename Storage>
+basic_big_integer<Storage> &basic_big_integer<Storage>::div_mod(basic_big_integer const &rhs, bool remainder)
 {
-    int64_t carry = 0;
-
-    for (int32_t i = (int) this->number.size() - 1; i >= 0; i--) {
-        carry = (carry << POWER) + this->number[i];
-        if (carry >= rhs) {
-            this->number[i] = (uint32_t) (carry / rhs);
-            carry %= rhs;
-        } else if ((uint32_t) i == this->number.size() - 1)
-            this->number.pop_back();
+    this->invalidate_hash();
+    if (compare_limbs(*this, rhs) < 0) {
+        if (!remainder)
+            *this = 0;
+        return *this;
+    }
+
+    size_t size = this->number.size(), rhs_size = rhs.number.size();
+    Storage quotient(size - rhs_size + 1), rest(rhs_size), scratch(div_scratch_size(size, rhs_size));
+    div_limbs(*this, rhs, quotient.data(), rest.data(), scratch.data());
+
+    if (remainder)
+        this->number = rest;
+    else {
+        this->number = quotient;
+        this->sign *= rhs.sign;
     }
+    this->trim();
 
-    return (uint32_t) carry;
+    return *this;
 }
 
-void big_integer::trim()
+template <typename Storage>
+void basic_big_integer<Storage>::trim()
 {
     while ((this->number.size() > 1) && (!this->number.back()))
         this->number.pop_back();
-}
\ No newline at end of file
+}
+
+// drops the cached hash, must be called before (this) is modified
+template <typename Storage>
+void basic_big_integer<Storage>::invalidate_hash()
+{
+#ifdef BIGINT_CACHED_HASH
+    __atomic_store_n(&this->hash_cache, 0, __ATOMIC_RELAXED);
+#endif
+}
+
+template struct basic_big_integer<container>;
+template struct basic_big_integer<shared_container>;
+template struct basic_big_integer<vector_container>;
+template struct basic_big_integer<sbo_container>;
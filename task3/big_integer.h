@@ -2,87 +2,124 @@
 #define BIG_INTEGER_H
 
 #include <iosfwd>
+#include <ostream>
 #include <string>
 #include "container_v1.h"
+#include "container_v2.2.h"
+#include "container_vector.h"
+#include "container_sbo.h"
+#include "big_integer_view.h"
 
 using namespace std;
 
-struct big_integer
+// arbitrary precision integer over a limb storage policy, (Storage) must provide
+// Storage(size), Storage(size, value), copying, resize, operator[], back, push_back,
+// pop_back, size, data (const and unsharing) and a conversion to limb_span
+template <typename Storage>
+struct basic_big_integer
 {
-	big_integer();
-	big_integer(big_integer const& other);
-	big_integer(int a);
-	explicit big_integer(std::string const& str);
-	~big_integer();
+	typedef Storage storage_type;
 
-	big_integer& operator=(big_integer const& other);
+	basic_big_integer();
+	basic_big_integer(basic_big_integer const& other);
+	basic_big_integer(int a);
+	explicit basic_big_integer(std::string const& str);
+	explicit basic_big_integer(big_integer_view const& view);
+	~basic_big_integer();
 
-	big_integer& operator+=(big_integer const& rhs);
-	big_integer& operator-=(big_integer const& rhs);
-	big_integer& operator*=(big_integer const& rhs);
-	big_integer& operator/=(big_integer const& rhs);
-	big_integer& operator%=(big_integer const& rhs);
+	basic_big_integer& operator=(basic_big_integer const& other);
 
-	big_integer& operator&=(big_integer const& rhs);
-	big_integer& operator|=(big_integer const& rhs);
-	big_integer& operator^=(big_integer const& rhs);
+	basic_big_integer& operator+=(basic_big_integer const& rhs);
+	basic_big_integer& operator-=(basic_big_integer const& rhs);
+	basic_big_integer& operator*=(basic_big_integer const& rhs);
+	basic_big_integer& operator/=(basic_big_integer const& rhs);
+	basic_big_integer& operator%=(basic_big_integer const& rhs);
 
-	big_integer& operator<<=(int rhs);
-	big_integer& operator>>=(int rhs);
+	basic_big_integer& operator&=(basic_big_integer const& rhs);
+	basic_big_integer& operator|=(basic_big_integer const& rhs);
+	basic_big_integer& operator^=(basic_big_integer const& rhs);
 
-	big_integer operator+() const;
-	big_integer operator-() const;
-	big_integer operator~() const;
+	basic_big_integer& operator<<=(int rhs);
+	basic_big_integer& operator>>=(int rhs);
 
-	big_integer& operator++();
-	big_integer operator++(int);
+	basic_big_integer operator+() const;
+	basic_big_integer operator-() const;
+	basic_big_integer operator~() const;
 
-	big_integer& operator--();
-	big_integer operator--(int);
+	basic_big_integer& operator++();
+	basic_big_integer operator++(int);
 
-	big_integer abs() const;
+	basic_big_integer& operator--();
+	basic_big_integer operator--(int);
 
-	friend bool operator==(big_integer const& a, big_integer const& b);
-	friend bool operator!=(big_integer const& a, big_integer const& b);
-	friend bool operator<(big_integer const& a, big_integer const& b);
-	friend bool operator>(big_integer const& a, big_integer const& b);
-	friend bool operator<=(big_integer const& a, big_integer const& b);
-	friend bool operator>=(big_integer const& a, big_integer const& b);
+	basic_big_integer abs() const;
 
-	friend std::string to_string(big_integer const& a);
+	// hash of the limbs and sign, consistent with big_integer_view (see big_integer_hash.h)
+	size_t hash() const;
+
+	operator limb_span() const { return limb_span(number.data(), number.size(), sign); }
+
+	friend basic_big_integer operator+(basic_big_integer a, basic_big_integer const& b) { return a += b; }
+	friend basic_big_integer operator-(basic_big_integer a, basic_big_integer const& b) { return a -= b; }
+	friend basic_big_integer operator*(basic_big_integer a, basic_big_integer const& b) { return a *= b; }
+	friend basic_big_integer operator/(basic_big_integer a, basic_big_integer const& b) { return a /= b; }
+	friend basic_big_integer operator%(basic_big_integer a, basic_big_integer const& b) { return a %= b; }
+
+	friend basic_big_integer operator&(basic_big_integer a, basic_big_integer const& b) { return a &= b; }
+	friend basic_big_integer operator|(basic_big_integer a, basic_big_integer const& b) { return a |= b; }
+	friend basic_big_integer operator^(basic_big_integer a, basic_big_integer const& b) { return a ^= b; }
+
+	friend basic_big_integer operator<<(basic_big_integer a, int b) { return a <<= b; }
+	friend basic_big_integer operator>>(basic_big_integer a, int b) { return a >>= b; }
+
+	friend bool operator==(basic_big_integer const& a, basic_big_integer const& b) { return big_integer_view(a) == big_integer_view(b); }
+	friend bool operator!=(basic_big_integer const& a, basic_big_integer const& b) { return !(a == b); }
+	friend bool operator<(basic_big_integer const& a, basic_big_integer const& b) { return compare(a, b) < 0; }
+	friend bool operator>(basic_big_integer const& a, basic_big_integer const& b) { return compare(a, b) > 0; }
+	friend bool operator<=(basic_big_integer const& a, basic_big_integer const& b) { return compare(a, b) <= 0; }
+	friend bool operator>=(basic_big_integer const& a, basic_big_integer const& b) { return compare(a, b) >= 0; }
+
+	friend std::string to_string(basic_big_integer const& a) { return a.to_decimal(); }
+	friend std::ostream& operator<<(std::ostream& s, basic_big_integer const& a) { return s << a.to_decimal(); }
+
+	friend struct big_accumulator;
 
 private:
-	big_integer convert() const;
-	big_integer add(big_integer const& rhs) const;
-	big_integer sub(big_integer const& rhs) const;
-	uint32_t div_long_short(uint32_t rhs);
+	static int compare(basic_big_integer const& a, basic_big_integer const& b);
+	std::string to_decimal() const;
+	void to_twos(size_t size, uint32_t* out) const;
+	basic_big_integer& bitwise(basic_big_integer const& rhs, void (*op)(limb_span, limb_span, uint32_t*));
+	basic_big_integer add(basic_big_integer const& rhs) const;
+	basic_big_integer sub(basic_big_integer const& rhs) const;
+	basic_big_integer& div_mod(basic_big_integer const& rhs, bool remainder);
 	void trim();
+	void invalidate_hash();
 
-	container number;
+	Storage number;
 	signed char sign;
-};
 
-big_integer operator+(big_integer a, big_integer const& b);
-big_integer operator-(big_integer a, big_integer const& b);
-big_integer operator*(big_integer a, big_integer const& b);
-big_integer operator/(big_integer a, big_integer const& b);
-big_integer operator%(big_integer a, big_integer const& b);
+#ifdef BIGINT_CACHED_HASH
+	mutable size_t hash_cache = 0;  // 0 means "not computed yet", accessed by relaxed atomics
+#endif
+};
 
-big_integer operator&(big_integer a, big_integer const& b);
-big_integer operator|(big_integer a, big_integer const& b);
-big_integer operator^(big_integer a, big_integer const& b);
+// the storages are compiled once in big_integer.cpp
+extern template struct basic_big_integer<container>;
+extern template struct basic_big_integer<shared_container>;
+extern template struct basic_big_integer<vector_container>;
+extern template struct basic_big_integer<sbo_container>;
 
-big_integer operator<<(big_integer a, int b);
-big_integer operator>>(big_integer a, int b);
+typedef basic_big_integer<container> intrusive_big_integer;
+typedef basic_big_integer<shared_container> shared_big_integer;
+typedef basic_big_integer<vector_container> vector_big_integer;
+typedef basic_big_integer<sbo_container> sbo_big_integer;
 
-bool operator==(big_integer const& a, big_integer const& b);
-bool operator!=(big_integer const& a, big_integer const& b);
-bool operator<(big_integer const& a, big_integer const& b);
-bool operator>(big_integer const& a, big_integer const& b);
-bool operator<=(big_integer const& a, big_integer const& b);
-bool operator>=(big_integer const& a, big_integer const& b);
+// storage of the default big_integer, must be the same in all translation units;
+// so must BIGINT_CACHED_HASH, it changes the layout of basic_big_integer
+#ifndef BIGINT_STORAGE
+#define BIGINT_STORAGE container
+#endif
 
-std::string to_string(big_integer const& a);
-std::ostream& operator<<(std::ostream& s, big_integer const& a);
+typedef basic_big_integer<BIGINT_STORAGE> big_integer;
 
 #endif // BIG_INTEGER_H
\ No newline at end of file
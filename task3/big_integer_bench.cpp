@@ -0,0 +1,197 @@
+// benchmark of big_integer operations over operand sizes and storages,
+// build it with the library sources, add -DBIGINT_STATS and bigint_stats.cpp to count allocations:
+//   g++ -O2 -std=c++14 big_integer_bench.cpp big_integer.cpp big_integer_view.cpp limb_kernels.cpp
+//       limb_allocator.cpp bigint_arena.cpp container_v1.cpp [bigint_stats.cpp]
+//
+// every line of the output is a JSON object of one case:
+//   {"backend": "vector", "op": "mul", "limbs": 1024, "iterations": 83, "ns_per_op": 1.2e+06, "allocs_per_op": 4}
+// allocs_per_op is null without BIGINT_STATS; a case which would run longer than --budget seconds
+// is reported as {"skipped": true} and larger sizes of the same operation are not tried
+//
+// options: --min-time s (0.2)   time to repeat every case for
+//          --budget s (2)       limit of one iteration, cases above it are skipped
+//          --max-limbs n (2^20) largest operand size, sizes are powers of 4 starting from 1
+//          --backend name       vector, shared, intrusive or sbo, all by default
+//          --op name            add, sub, mul, div, mod, and, or, xor, shl, shr, to_string, parse
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include "big_integer.h"
+#ifdef BIGINT_STATS
+#include "bigint_stats.h"
+#endif
+
+namespace {
+    struct options {
+        double min_time = 0.2;
+        double budget = 2;
+        size_t max_limbs = 1 << 20;
+        std::string backend, op;
+    };
+
+    enum operation { ADD, SUB, MUL, DIV, MOD, AND, OR, XOR, SHL, SHR, TO_STRING, PARSE, OPERATIONS };
+
+    const char* const OPS[OPERATIONS] = {
+            "add", "sub", "mul", "div", "mod", "and", "or", "xor", "shl", "shr", "to_string", "parse"
+    };
+
+    // how many times longer an operation takes on 4 times longer operands: Karatsuba multiplies
+    // in O(n^log2(3)), division and radix conversion are quadratic, the rest are linear
+    const double GROWTH[OPERATIONS] = {4, 4, 9, 16, 16, 4, 4, 4, 4, 4, 16, 16};
+
+    // the shift of shl and shr, not a multiple of the limb size
+    const int SHIFT = 1000;
+
+    volatile size_t sink;    // results are fed here, so they are not optimized out
+
+    double now()
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    uint64_t allocations()
+    {
+#ifdef BIGINT_STATS
+        return bigint_stats::allocations;
+#else
+        return 0;
+#endif
+    }
+
+    template <typename B>
+    B random_number(std::mt19937& gen, size_t limbs)
+    {
+        std::vector<uint32_t> data(limbs);
+        for (size_t i = 0; i < limbs; i++)
+            data[i] = gen() & ((1u << 30) - 1);
+        data[limbs - 1] |= 1u << 29;    // exactly (limbs) limbs
+        return B(big_integer_view(data.data(), limbs, gen() & 1 ? 1 : -1));
+    }
+
+    // a decimal string of about the same size as (limbs) limbs
+    std::string random_digits(std::mt19937& gen, size_t limbs)
+    {
+        size_t digits = limbs * 9 + 1;  // a limb holds 30 * log10(2) ~ 9.03 digits
+        std::string s(digits, '0');
+        for (size_t i = 0; i < digits; i++)
+            s[i] = (char) ('0' + gen() % 10);
+        s[0] = (char) ('1' + gen() % 9);
+        return s;
+    }
+
+    template <typename B>
+    size_t size_of(B const& a)
+    {
+        return big_integer_view(a).size;
+    }
+
+    template <typename B>
+    void run_op(operation op, B const& a, B const& b, std::string const& digits)
+    {
+        switch (op) {
+            case ADD: sink = sink + size_of(a + b); break;
+            case SUB: sink = sink + size_of(a - b); break;
+            case MUL: sink = sink + size_of(a * b); break;
+            case DIV: sink = sink + size_of(a / b); break;
+            case MOD: sink = sink + size_of(a % b); break;
+            case AND: sink = sink + size_of(a & b); break;
+            case OR: sink = sink + size_of(a | b); break;
+            case XOR: sink = sink + size_of(a ^ b); break;
+            case SHL: sink = sink + size_of(a << SHIFT); break;
+            case SHR: sink = sink + size_of(a >> SHIFT); break;
+            case TO_STRING: sink = sink + to_string(a).size(); break;
+            default: sink = sink + size_of(B(digits)); break;
+        }
+    }
+
+    template <typename B>
+    void run_backend(char const* backend, options const& opt)
+    {
+        if (!opt.backend.empty() && opt.backend != backend)
+            return;
+
+        for (int i = 0; i < OPERATIONS; i++) {
+            operation op = (operation) i;
+            if (!opt.op.empty() && opt.op != OPS[op])
+                continue;
+
+            bool skip = false;
+            double previous = 0;    // seconds per iteration of the previous size
+            for (size_t limbs = 1; limbs <= opt.max_limbs; limbs *= 4) {
+                if (skip) {
+                    std::printf("{\"backend\": \"%s\", \"op\": \"%s\", \"limbs\": %zu, \"skipped\": true}\n",
+                                backend, OPS[op], limbs);
+                    continue;
+                }
+
+                // the same operands for every backend
+                std::mt19937 gen((unsigned) limbs);
+                B a = random_number<B>(gen, limbs);
+                // division is the most interesting when the quotient is as long as the divisor
+                B b = random_number<B>(gen, (op == DIV || op == MOD) ? (limbs + 1) / 2 : limbs);
+                std::string digits = op == PARSE ? random_digits(gen, limbs) : std::string();
+
+                size_t iterations = 0;
+                uint64_t allocs = allocations();
+                double start = now(), elapsed = 0;
+                do {
+                    run_op(op, a, b, digits);
+                    iterations++;
+                    elapsed = now() - start;
+                } while (elapsed < opt.min_time && elapsed / iterations < opt.budget);
+                allocs = allocations() - allocs;
+
+                double ns = elapsed / iterations * 1e9;
+                std::printf("{\"backend\": \"%s\", \"op\": \"%s\", \"limbs\": %zu, \"iterations\": %zu, "
+                            "\"ns_per_op\": %.6g, \"allocs_per_op\": ",
+                            backend, OPS[op], limbs, iterations, ns);
+#ifdef BIGINT_STATS
+                std::printf("%.6g}\n", (double) allocs / iterations);
+#else
+                std::printf("null}\n");
+#endif
+                std::fflush(stdout);
+
+                // small sizes are dominated by the overhead, so the growth seen between the last two sizes
+                // may be below the asymptotic one, the larger of them predicts the next size
+                double time = elapsed / iterations;
+                double growth = previous > 0 ? std::max(GROWTH[op], time / previous) : GROWTH[op];
+                skip = time * growth > opt.budget;
+                previous = time;
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    options opt;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!std::strcmp(argv[i], "--min-time"))
+            opt.min_time = std::atof(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--budget"))
+            opt.budget = std::atof(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--max-limbs"))
+            opt.max_limbs = (size_t) std::atoll(argv[i + 1]);
+        else if (!std::strcmp(argv[i], "--backend"))
+            opt.backend = argv[i + 1];
+        else if (!std::strcmp(argv[i], "--op"))
+            opt.op = argv[i + 1];
+        else {
+            std::fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    run_backend<vector_big_integer>("vector", opt);
+    run_backend<shared_big_integer>("shared", opt);
+    run_backend<intrusive_big_integer>("intrusive", opt);
+    run_backend<sbo_big_integer>("sbo", opt);
+    return 0;
+}
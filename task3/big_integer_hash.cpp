@@ -0,0 +1,69 @@
+#include "big_integer_hash.h"
+
+const uint64_t PRIME1 = 0x9E3779B185EBCA87ULL;
+const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+const uint64_t PRIME3 = 0x165667B19E3779F9ULL;
+
+static inline uint64_t rotl(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+static inline uint64_t mix_round(uint64_t acc, uint64_t input)
+{
+    acc += input * PRIME2;
+    return rotl(acc, 31) * PRIME1;
+}
+
+// xxhash-like: four independent lanes eat two limbs each per step,
+// so the main loop has no dependency between lanes and vectorizes well
+size_t hash_limbs(big_integer_view const &a)
+{
+    uint64_t lanes[4] = {PRIME1 + PRIME2, PRIME2, 0, 0 - PRIME1};
+
+    size_t i = 0;
+    for (; i + 8 <= a.size; i += 8) {
+        for (size_t k = 0; k < 4; k++) {
+            uint64_t word = a.data[i + 2 * k] | ((uint64_t) a.data[i + 2 * k + 1] << 32);
+            lanes[k] = mix_round(lanes[k], word);
+        }
+    }
+
+    uint64_t h = rotl(lanes[0], 1) + rotl(lanes[1], 7) + rotl(lanes[2], 12) + rotl(lanes[3], 18);
+    h += (uint64_t) a.size * PRIME3;
+    if (a.sign < 0)
+        h = ~h;
+
+    for (; i < a.size; i++)
+        h = rotl(h ^ (a.data[i] * PRIME1), 23) * PRIME2 + PRIME3;
+
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    h ^= h >> 32;
+
+    // zero is reserved for "no cached hash" in big_integer
+    return h ? (size_t) h : (size_t) PRIME3;
+}
+
+template <typename Storage>
+size_t basic_big_integer<Storage>::hash() const
+{
+#ifdef BIGINT_CACHED_HASH
+    // a const key may be hashed by several threads at once, all of them store the same value
+    size_t h = __atomic_load_n(&this->hash_cache, __ATOMIC_RELAXED);
+    if (h == 0) {
+        h = hash_limbs(*this);
+        __atomic_store_n(&this->hash_cache, h, __ATOMIC_RELAXED);
+    }
+    return h;
+#else
+    return hash_limbs(*this);
+#endif
+}
+
+template size_t basic_big_integer<container>::hash() const;
+template size_t basic_big_integer<shared_container>::hash() const;
+template size_t basic_big_integer<vector_container>::hash() const;
+template size_t basic_big_integer<sbo_container>::hash() const;
@@ -0,0 +1,46 @@
+#ifndef BIG_INTEGER_HASH_H
+#define BIG_INTEGER_HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include "big_integer.h"
+
+size_t hash_limbs(big_integer_view const& a);
+
+// transparent hash and equality: lookups may take a big_integer_view without constructing a key
+struct big_integer_hash {
+    typedef void is_transparent;
+
+    template <typename Storage>
+    size_t operator()(basic_big_integer<Storage> const& a) const
+    {
+        return a.hash();
+    }
+
+    size_t operator()(big_integer_view const& a) const
+    {
+        return hash_limbs(a);
+    }
+};
+
+struct big_integer_equal {
+    typedef void is_transparent;
+
+    bool operator()(big_integer_view const& a, big_integer_view const& b) const
+    {
+        return a == b;
+    }
+};
+
+namespace std {
+    template <typename Storage>
+    struct hash< basic_big_integer<Storage> > {
+        size_t operator()(basic_big_integer<Storage> const& a) const
+        {
+            return a.hash();
+        }
+    };
+}
+
+#endif // BIG_INTEGER_HASH_H
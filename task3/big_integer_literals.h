@@ -0,0 +1,100 @@
+#ifndef BIG_INTEGER_LITERALS_H
+#define BIG_INTEGER_LITERALS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "big_integer.h"
+
+// 123456789012345678901234567890_bi, 0xDEADBEEFDEADBEEFDEADBEEF_bi, 1'000'000'000'000_bi,
+// 0b1010_bi; a leading zero means octal like in built-in literals, 0123_bi == 83
+// digits are converted to limbs at compile time, at runtime the limbs are only copied;
+// with BIGINT_STATIC_LITERALS every literal is a static constant and its (copy-on-write) copies share the limbs;
+// a literal may be used by several threads, so that needs BIGINT_ATOMIC_REFCOUNT (see container_v2.2.h)
+#if defined(BIGINT_STATIC_LITERALS) && !defined(BIGINT_ATOMIC_REFCOUNT)
+#error "big_integer: BIGINT_STATIC_LITERALS needs BIGINT_ATOMIC_REFCOUNT"
+#endif
+
+namespace big_integer_literals {
+    namespace detail {
+        const uint32_t POWER = 30, MASK = (1u << POWER) - 1;
+
+        template <size_t N>
+        struct limbs {
+            uint32_t data[N];
+            size_t size;
+        };
+
+        constexpr uint32_t digit(char c)
+        {
+            return ('0' <= c && c <= '9') ? (uint32_t) (c - '0')
+                 : ('a' <= c && c <= 'f') ? (uint32_t) (c - 'a' + 10)
+                 : ('A' <= c && c <= 'F') ? (uint32_t) (c - 'A' + 10)
+                 : 16;
+        }
+
+        // a digit takes at most 4 bits
+        template <size_t N>
+        constexpr limbs<N * 4 / POWER + 1> parse(char const (&str)[N])
+        {
+            limbs<N * 4 / POWER + 1> result{};
+            result.size = 1;
+
+            size_t i = 0;
+            uint32_t base = 10;
+            if (N > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X')) {
+                base = 16;
+                i = 2;
+            } else if (N > 2 && str[0] == '0' && (str[1] == 'b' || str[1] == 'B')) {
+                base = 2;
+                i = 2;
+            } else if (N > 1 && str[0] == '0') {
+                base = 8;
+                i = 1;
+            }
+
+            for (; i < N; i++) {
+                if (str[i] == '\'')
+                    continue;
+                if (digit(str[i]) >= base)
+                    throw "big_integer: invalid digit in a _bi literal";
+
+                uint64_t carry = digit(str[i]);
+                for (size_t j = 0; j < result.size; j++) {
+                    carry += (uint64_t) result.data[j] * base;
+                    result.data[j] = (uint32_t) (carry & MASK);
+                    carry >>= POWER;
+                }
+                if (carry != 0)
+                    result.data[result.size++] = (uint32_t) carry;
+            }
+
+            return result;
+        }
+
+        template <char... Cs>
+        struct literal {
+            static constexpr char str[sizeof...(Cs)] = {Cs...};
+            static constexpr limbs<sizeof...(Cs) * 4 / POWER + 1> value = parse(str);
+        };
+
+        template <char... Cs>
+        constexpr char literal<Cs...>::str[sizeof...(Cs)];
+
+        template <char... Cs>
+        constexpr limbs<sizeof...(Cs) * 4 / POWER + 1> literal<Cs...>::value;
+    }
+
+    template <char... Cs>
+    big_integer operator"" _bi()
+    {
+        typedef detail::literal<Cs...> literal;
+#ifdef BIGINT_STATIC_LITERALS
+        static const big_integer value(big_integer_view(literal::value.data, literal::value.size, 1));
+        return value;
+#else
+        return big_integer(big_integer_view(literal::value.data, literal::value.size, 1));
+#endif
+    }
+}
+
+#endif // BIG_INTEGER_LITERALS_H
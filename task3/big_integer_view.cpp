@@ -0,0 +1,21 @@
+#include <cstring>
+#include "big_integer_view.h"
+
+big_integer_view::big_integer_view(uint32_t const *data, size_t size, signed char sign) :
+        big_integer_view(limb_span(data, size, sign))
+{}
+
+big_integer_view::big_integer_view(limb_span span) :
+        limb_span(span)
+{
+    while (this->size > 0 && data[this->size - 1] == 0)
+        this->size--;
+    if (this->size == 0)
+        this->sign = 1;
+}
+
+bool operator==(big_integer_view const &a, big_integer_view const &b)
+{
+    return a.sign == b.sign && a.size == b.size
+           && (a.size == 0 || !std::memcmp(a.data, b.data, a.size * sizeof(uint32_t)));
+}
@@ -0,0 +1,22 @@
+#ifndef BIG_INTEGER_VIEW_H
+#define BIG_INTEGER_VIEW_H
+
+#include <cstddef>
+#include <cstdint>
+#include "limb_span.h"
+
+template <typename Storage>
+struct basic_big_integer;
+
+// limb span of a big_integer, high zero limbs are skipped
+// and zero is always positive, so equal numbers have equal views
+struct big_integer_view : limb_span {
+    template <typename Storage>
+    big_integer_view(basic_big_integer<Storage> const& a) : big_integer_view(static_cast<limb_span>(a)) {}
+    big_integer_view(limb_span span);
+    big_integer_view(uint32_t const* data, size_t size, signed char sign);
+};
+
+bool operator==(big_integer_view const& a, big_integer_view const& b);
+
+#endif // BIG_INTEGER_VIEW_H
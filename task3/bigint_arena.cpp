@@ -0,0 +1,102 @@
+#include <algorithm>
+#include <new>
+#include "bigint_arena.h"
+#include "limb_allocator.h"
+
+// in front of every buffer, it keeps buffers aligned like the limb allocators do
+struct alignas(LIMB_ALIGNMENT) bigint_arena::header {
+    void* owner;                // nullptr if the buffer is released
+    void (*move_out)(void*);
+    size_t bytes;               // including the header
+};
+
+struct alignas(LIMB_ALIGNMENT) bigint_arena::chunk {
+    chunk* next;
+    char* top;
+    char* end;
+};
+
+namespace {
+    thread_local bigint_arena* innermost = nullptr;
+}
+
+bigint_arena::bigint_arena(size_t chunk_size) :
+        chunks(nullptr),
+        chunk_size(chunk_size),
+        previous(innermost)
+{
+    innermost = this;
+}
+
+bigint_arena::~bigint_arena()
+{
+    innermost = previous;       // escaped values go to the enclosing arena or to the heap
+    evacuate();
+    while (chunks) {
+        chunk* next = chunks->next;
+        heap_limb_allocator::deallocate(reinterpret_cast<uint32_t*>(chunks), 0);
+        chunks = next;
+    }
+}
+
+bigint_arena* bigint_arena::current()
+{
+    return innermost;
+}
+
+uint32_t* bigint_arena::allocate(size_t size, void* owner, void (*evacuate)(void*))
+{
+    size_t bytes = sizeof(header) + ((size * sizeof(uint32_t) + alignof(header) - 1) & ~(alignof(header) - 1));
+    if (!chunks || static_cast<size_t>(chunks->end - chunks->top) < bytes)
+        add_chunk(std::max(bytes, chunk_size * sizeof(uint32_t)));
+
+    header* h = reinterpret_cast<header*>(chunks->top);
+    chunks->top += bytes;
+    h->owner = owner;
+    h->move_out = evacuate;
+    h->bytes = bytes;
+    return reinterpret_cast<uint32_t*>(h + 1);
+}
+
+void bigint_arena::release(uint32_t* ptr)
+{
+    (reinterpret_cast<header*>(ptr) - 1)->owner = nullptr;
+}
+
+void bigint_arena::reset()
+{
+    bigint_arena* saved = innermost;
+    innermost = previous;
+    evacuate();
+    innermost = saved;
+
+    if (!chunks)
+        return;
+    while (chunks->next) {      // the oldest chunk is kept for the next round
+        chunk* next = chunks->next;
+        heap_limb_allocator::deallocate(reinterpret_cast<uint32_t*>(chunks), 0);
+        chunks = next;
+    }
+    chunks->top = reinterpret_cast<char*>(chunks + 1);
+}
+
+void bigint_arena::evacuate()
+{
+    for (chunk* c = chunks; c; c = c->next) {
+        for (char* p = reinterpret_cast<char*>(c + 1); p < c->top; ) {
+            header* h = reinterpret_cast<header*>(p);
+            if (h->owner)
+                h->move_out(h->owner);
+            p += h->bytes;
+        }
+    }
+}
+
+void bigint_arena::add_chunk(size_t bytes)
+{
+    chunk* c = reinterpret_cast<chunk*>(heap_limb_allocator::allocate((sizeof(chunk) + bytes) / sizeof(uint32_t)));
+    c->next = chunks;
+    c->top = reinterpret_cast<char*>(c + 1);
+    c->end = c->top + bytes;
+    chunks = c;
+}
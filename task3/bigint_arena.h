@@ -0,0 +1,42 @@
+#ifndef BIGINT_ARENA_H
+#define BIGINT_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+
+// while a bigint_arena is alive, long data of containers created in its thread
+// is bump-allocated from its chunks and all of it is dropped at once by reset() or at the end of the scope;
+// numbers which are still alive then (escaped values) are moved out of the arena by their containers,
+// to the enclosing arena if there is one, to the heap otherwise;
+// such numbers must not be passed to other threads before the arena ends
+struct bigint_arena {
+    explicit bigint_arena(size_t chunk_size = 1 << 16);     // in words
+    ~bigint_arena();
+
+    bigint_arena(bigint_arena const&) = delete;
+    bigint_arena& operator=(bigint_arena const&) = delete;
+
+    // the innermost arena of the calling thread, nullptr if there is none
+    static bigint_arena* current();
+
+    // (size) words owned by (owner), which is moved out by (evacuate) if it is still alive at reset()
+    uint32_t* allocate(size_t size, void* owner, void (*evacuate)(void*));
+    // the owner does not use the buffer anymore
+    static void release(uint32_t* ptr);
+
+    // moves escaped values out and frees everything except the first chunk
+    void reset();
+
+private:
+    struct header;
+    struct chunk;
+
+    chunk* chunks;          // the last allocated chunk goes first
+    size_t chunk_size;
+    bigint_arena* previous;
+
+    void evacuate();
+    void add_chunk(size_t bytes);
+};
+
+#endif // BIGINT_ARENA_H
@@ -0,0 +1,57 @@
+#include <ostream>
+#include "bigint_stats.h"
+
+#ifdef BIGINT_STATS
+
+std::atomic<uint64_t> bigint_stats::allocations{0};
+std::atomic<uint64_t> bigint_stats::deallocations{0};
+std::atomic<uint64_t> bigint_stats::allocated_bytes{0};
+std::atomic<uint64_t> bigint_stats::unshares{0};
+std::atomic<uint64_t> bigint_stats::resizes{0};
+std::atomic<uint64_t> bigint_stats::operand_limbs[OPERATIONS][BUCKETS];
+
+char const* bigint_stats::name(operation op)
+{
+    static char const* const names[OPERATIONS] = {
+            "add", "sub", "mul", "div", "mod", "and", "or", "xor", "shl", "shr", "cmp"
+    };
+    return names[op];
+}
+
+void bigint_stats::reset()
+{
+    allocations = 0;
+    deallocations = 0;
+    allocated_bytes = 0;
+    unshares = 0;
+    resizes = 0;
+    for (size_t op = 0; op < OPERATIONS; op++)
+        for (size_t k = 0; k < BUCKETS; k++)
+            operand_limbs[op][k] = 0;
+}
+
+void bigint_stats::dump(std::ostream& s)
+{
+    s << "{\"allocations\": " << allocations
+      << ", \"deallocations\": " << deallocations
+      << ", \"allocated_bytes\": " << allocated_bytes
+      << ", \"unshares\": " << unshares
+      << ", \"resizes\": " << resizes
+      << ", \"operand_limbs\": {";
+
+    for (size_t op = 0; op < OPERATIONS; op++) {
+        s << (op ? ", \"" : "\"") << name((operation) op) << "\": {";
+        bool first = true;
+        for (size_t k = 0; k < BUCKETS; k++) {
+            uint64_t count = operand_limbs[op][k];
+            if (count == 0)
+                continue;
+            s << (first ? "\"" : ", \"") << ((uint64_t) 1 << k) << "\": " << count;
+            first = false;
+        }
+        s << "}";
+    }
+    s << "}}";
+}
+
+#endif // BIGINT_STATS
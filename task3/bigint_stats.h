@@ -0,0 +1,80 @@
+#ifndef BIGINT_STATS_H
+#define BIGINT_STATS_H
+
+#include <cstddef>
+#include <cstdint>
+
+// define BIGINT_STATS (in all translation units, and link bigint_stats.cpp) to count
+// what containers and big_integer do: allocations of long data and their bytes,
+// copy-on-write unshares (deep copies of shared data), resizes (moves of limbs to a new buffer)
+// and sizes of operands of every operation (including the ones big_integer calls internally,
+// e.g. operator% counts a division, a multiplication and a subtraction too); otherwise BIGINT_STAT(...) compiles to nothing
+#ifdef BIGINT_STATS
+
+#include <atomic>
+#include <iosfwd>
+
+struct bigint_stats {
+    enum operation { ADD, SUB, MUL, DIV, MOD, AND, OR, XOR, SHL, SHR, CMP, OPERATIONS };
+
+    // operand sizes are counted in buckets [2^k; 2^(k + 1)) limbs, an empty operand goes to the first one
+    static const size_t BUCKETS = 40;
+
+    static std::atomic<uint64_t> allocations, deallocations, allocated_bytes, unshares, resizes;
+    static std::atomic<uint64_t> operand_limbs[OPERATIONS][BUCKETS];
+
+    static void allocation(size_t bytes)
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    static void deallocation()
+    {
+        deallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void unshare()
+    {
+        unshares.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void resize()
+    {
+        resizes.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void operand(operation op, size_t limbs)
+    {
+        operand_limbs[op][bucket(limbs)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void operands(operation op, size_t a, size_t b)
+    {
+        operand(op, a);
+        operand(op, b);
+    }
+
+    static size_t bucket(size_t limbs)
+    {
+        size_t k = limbs > 1 ? 63 - __builtin_clzll(limbs) : 0;
+        return k < BUCKETS ? k : BUCKETS - 1;
+    }
+
+    static char const* name(operation op);
+
+    static void reset();
+    // {"allocations": .., "deallocations": .., "allocated_bytes": .., "unshares": .., "resizes": ..,
+    //  "operand_limbs": {"add": {"1": count, "2": count, "4": ..}, ..}}, empty buckets are skipped
+    static void dump(std::ostream& s);
+};
+
+#define BIGINT_STAT(call) bigint_stats::call
+
+#else
+
+#define BIGINT_STAT(call) ((void) 0)
+
+#endif // BIGINT_STATS
+
+#endif // BIGINT_STATS_H
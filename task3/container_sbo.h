@@ -0,0 +1,296 @@
+#ifndef BIGINT_CONTAINER_SBO_H
+#define BIGINT_CONTAINER_SBO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <iostream>
+#include "limb_allocator.h"
+#include "bigint_stats.h"
+#include "limb_span.h"
+
+#ifndef BIGINT_INLINE_LIMBS
+#define BIGINT_INLINE_LIMBS 12
+#endif
+
+// small buffer storage: up to N limbs are stored inline like in container_v2.2.h,
+// but long data has a single owner and is copied eagerly, so there are
+// no owner counters to touch and writes never check for sharing
+template <size_t N, typename Alloc = BIGINT_DEFAULT_ALLOCATOR>
+struct basic_sbo_container {
+    static_assert(N >= 1, "big_integer: container: at least one limb must be stored inline");
+
+    basic_sbo_container();
+    basic_sbo_container(size_t size);
+    basic_sbo_container(size_t size, uint32_t value);
+    basic_sbo_container(basic_sbo_container const& other);
+
+    ~basic_sbo_container();
+
+    void assign(size_t size, uint32_t value);
+    void resize(size_t size);
+    void reserve(size_t size);
+
+    basic_sbo_container& operator=(basic_sbo_container const& other);
+
+    uint32_t const& operator[](size_t i) const;
+    uint32_t& operator[](size_t i);
+
+    uint32_t const& back() const;
+    uint32_t& back();
+
+    void push_back(uint32_t const& value);
+    void pop_back();
+
+    size_t size() const;
+    uint32_t const* data() const;
+    uint32_t* data();
+
+    operator limb_span() const;
+
+private:
+    size_t sz, capacity = N;    // capacity == N means that data short is used
+    union {
+        uint32_t data_short[N];
+        uint32_t* data_long;
+    };
+
+    uint32_t* limbs();
+    uint32_t const* limbs() const;
+
+    // long data is padded to whole LIMB_ALIGNMENT blocks like in container_v2.2.h
+    static size_t words(size_t capacity);
+    static uint32_t* allocate(size_t capacity);
+    void reallocate(size_t capacity);
+    void delete_data_long();
+};
+
+typedef basic_sbo_container<BIGINT_INLINE_LIMBS> sbo_container;
+
+template <size_t N, typename Alloc>
+basic_sbo_container<N, Alloc>::basic_sbo_container()
+        : sz(0)
+{}
+
+template <size_t N, typename Alloc>
+basic_sbo_container<N, Alloc>::basic_sbo_container(size_t sz)
+        : basic_sbo_container(sz, 0)
+{}
+
+template <size_t N, typename Alloc>
+basic_sbo_container<N, Alloc>::basic_sbo_container(size_t sz, uint32_t value)
+        : sz(sz)
+{
+    if (sz > N) {
+        data_long = allocate(sz);
+        capacity = sz;
+    }
+    std::fill_n(limbs(), sz, value);
+}
+
+template <size_t N, typename Alloc>
+basic_sbo_container<N, Alloc>::basic_sbo_container(basic_sbo_container const& other)
+        : sz(other.sz)
+{
+    if (sz > N) {               // the copy gets exactly as much as it needs
+        data_long = allocate(sz);
+        capacity = sz;
+    }
+    std::copy_n(other.limbs(), sz, limbs());
+}
+
+template <size_t N, typename Alloc>
+basic_sbo_container<N, Alloc>::~basic_sbo_container()
+{
+    if (capacity > N)
+        delete_data_long();
+}
+
+template <size_t N, typename Alloc>
+void basic_sbo_container<N, Alloc>::assign(size_t sz, uint32_t value)
+{
+    if (sz > capacity) {
+        if (capacity > N)
+            delete_data_long();
+        data_long = allocate(sz);
+        capacity = sz;
+    }
+    std::fill_n(limbs(), sz, value);
+    this->sz = sz;
+}
+
+template <size_t N, typename Alloc>
+void basic_sbo_container<N, Alloc>::resize(size_t sz)
+{
+    if (sz > capacity)                  // grow geometrically, so push_back is amortized O(1)
+        reallocate(std::max(sz, capacity << 1));
+
+    if (sz > this->sz)
+        std::fill_n(limbs() + this->sz, sz - this->sz, 0);
+    this->sz = sz;
+}
+
+template <size_t N, typename Alloc>
+void basic_sbo_container<N, Alloc>::reserve(size_t sz)
+{
+    if (sz > capacity)
+        reallocate(sz);
+}
+
+template <size_t N, typename Alloc>
+basic_sbo_container<N, Alloc>& basic_sbo_container<N, Alloc>::operator=(basic_sbo_container const& other)
+{
+    if (this == &other)
+        return *this;
+
+    if (other.sz > capacity) {          // our storage is reused whenever it is large enough
+        uint32_t* buffer = allocate(other.sz);
+        if (capacity > N)
+            delete_data_long();
+        data_long = buffer;
+        capacity = other.sz;
+    }
+    std::copy_n(other.limbs(), other.sz, limbs());
+    sz = other.sz;
+
+    return *this;
+}
+
+template <size_t N, typename Alloc>
+uint32_t const& basic_sbo_container<N, Alloc>::operator[](size_t i) const
+{
+    if (capacity == N && i >= N)
+        throw std::out_of_range("big integer: container: in function operator[]");
+    return limbs()[i];
+}
+
+template <size_t N, typename Alloc>
+uint32_t& basic_sbo_container<N, Alloc>::operator[](size_t i)
+{
+    if (capacity == N && i >= N)
+        throw std::out_of_range("big integer: container: in function operator[]");
+    return limbs()[i];
+}
+
+template <size_t N, typename Alloc>
+uint32_t const& basic_sbo_container<N, Alloc>::back() const
+{
+    if (sz == 0)
+        throw std::out_of_range(
+                "big_integer: container: in function back(): no elements"
+        );
+
+    return limbs()[sz - 1];
+}
+
+template <size_t N, typename Alloc>
+uint32_t& basic_sbo_container<N, Alloc>::back()
+{
+    if (sz == 0)
+        throw std::out_of_range(
+                "big_integer: container: in function back(): no elements"
+        );
+
+    return limbs()[sz - 1];
+}
+
+template <size_t N, typename Alloc>
+void basic_sbo_container<N, Alloc>::push_back(uint32_t const& value)
+{
+    uint32_t temp = value;  // (value) may live in our storage
+    if (sz == capacity)
+        reallocate(capacity << 1);
+    limbs()[sz++] = temp;
+}
+
+template <size_t N, typename Alloc>
+void basic_sbo_container<N, Alloc>::pop_back()
+{
+    if (sz == 0)
+        throw std::out_of_range(
+                "big_integer: container: in function pop_back(): no elements"
+        );
+
+    sz--;
+}
+
+template <size_t N, typename Alloc>
+size_t basic_sbo_container<N, Alloc>::size() const
+{
+    return sz;
+}
+
+template <size_t N, typename Alloc>
+uint32_t const* basic_sbo_container<N, Alloc>::data() const
+{
+    return limbs();
+}
+
+template <size_t N, typename Alloc>
+uint32_t* basic_sbo_container<N, Alloc>::data()
+{
+    return limbs();
+}
+
+template <size_t N, typename Alloc>
+basic_sbo_container<N, Alloc>::operator limb_span() const
+{
+    return limb_span(limbs(), sz);
+}
+
+template <size_t N, typename Alloc>
+uint32_t* basic_sbo_container<N, Alloc>::limbs()
+{
+    return (capacity == N) ? data_short : data_long;
+}
+
+template <size_t N, typename Alloc>
+uint32_t const* basic_sbo_container<N, Alloc>::limbs() const
+{
+    return (capacity == N) ? data_short : data_long;
+}
+
+template <size_t N, typename Alloc>
+size_t basic_sbo_container<N, Alloc>::words(size_t capacity)
+{
+    const size_t BLOCK = LIMB_ALIGNMENT / sizeof(uint32_t);
+    return (capacity + BLOCK - 1) & ~(BLOCK - 1);
+}
+
+template <size_t N, typename Alloc>
+uint32_t* basic_sbo_container<N, Alloc>::allocate(size_t capacity)
+{
+    try {
+        uint32_t* ptr = Alloc::allocate(words(capacity));
+        BIGINT_STAT(allocation(words(capacity) * sizeof(uint32_t)));
+        return ptr;
+    } catch (std::bad_alloc& e) {
+        std::cout << "unsuccessful memory allocation: " << e.what() << std::endl;
+        throw e;
+    }
+}
+
+// moves the elements to a new long data of the given capacity
+template <size_t N, typename Alloc>
+void basic_sbo_container<N, Alloc>::reallocate(size_t capacity)
+{
+    BIGINT_STAT(resize());
+    uint32_t* buffer = allocate(capacity);
+    std::copy_n(limbs(), sz, buffer);
+
+    if (this->capacity > N)
+        delete_data_long();
+    data_long = buffer;
+    this->capacity = capacity;
+}
+
+template <size_t N, typename Alloc>
+void basic_sbo_container<N, Alloc>::delete_data_long()
+{
+    BIGINT_STAT(deallocation());
+    Alloc::deallocate(data_long, words(capacity));
+    capacity = N;
+}
+
+#endif //BIGINT_CONTAINER_SBO_H
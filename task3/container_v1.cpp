@@ -1,19 +1,27 @@
 #include <stdexcept>
 #include <iostream>
 #include "container_v1.h"
+#include "bigint_stats.h"
 
-container::container()
+// long data and its owner counter are taken from the limb allocator
+template <typename... Args>
+std::shared_ptr<shared_container::storage> shared_container::make_storage(Args const&... args)
+{
+    return std::allocate_shared<storage>(limb_std_allocator<storage>(), args...);
+}
+
+shared_container::shared_container()
     : sz(0)
 {}
 
-container::container(size_t size)
+shared_container::shared_container(size_t size)
     : sz(size)
 {
     if (size > 1)
-        data_long = std::make_shared< std::vector<uint32_t> >(size);
+        data_long = make_storage(size);
 }
 
-container::container(const container &other)
+shared_container::shared_container(const shared_container &other)
     : sz(other.sz)
 {
     if (sz == 1)
@@ -22,23 +30,23 @@ container::container(const container &other)
         data_long = other.data_long;
 }
 
-container::container(size_t size, uint32_t value)
+shared_container::shared_container(size_t size, uint32_t value)
     : sz(size)
 {
     if (size == 1)
         data_short = value;
     else
-        data_long = std::make_shared< std::vector<uint32_t> >(size, value);
+        data_long = make_storage(size, value);
 }
 
-container::~container()
+shared_container::~shared_container()
 {}
 
-void container::assign(size_t sz, uint32_t value)
+void shared_container::assign(size_t sz, uint32_t value)
 {
     if (sz > 1) {
         this->sz = sz;
-        data_long = std::make_shared< std::vector<uint32_t> >(sz, value);
+        data_long = make_storage(sz, value);
         return;
     }
 
@@ -48,25 +56,28 @@ void container::assign(size_t sz, uint32_t value)
     this->sz = sz;
 }
 
-void container::resize(size_t sz)
+void shared_container::resize(size_t sz)
 {
     if (this->sz > 1) {
         if (sz > 1) {
             real_copy();
+            size_t capacity = data_long->capacity();
             data_long->resize(sz);
+            if (data_long->capacity() != capacity)
+                BIGINT_STAT(resize());
         } else if (sz == 1) {
             data_short = (*data_long)[0];
             data_long.reset();
         }
     } else if (sz > 1) {
-        data_long = std::make_shared< std::vector<uint32_t> >(sz);
+        data_long = make_storage(sz);
         if (this->sz == 1)
             (*data_long)[0] = data_short;
     }
     this->sz = sz;
 }
 
-void container::reserve(size_t sz)
+void shared_container::reserve(size_t sz)
 {
     if (sz <= this->sz)
         return;
@@ -74,41 +85,69 @@ void container::reserve(size_t sz)
     if (this->sz > 1)
         real_copy();
     else
-        data_long = std::make_shared< std::vector<uint32_t> >(1, data_short);
+        data_long = make_storage(1, data_short);
 
     data_long->reserve(sz);
 }
 
-void container::copy(size_t i, container const &other, size_t l, size_t r)
+// the same as insert_range, but the range must not be empty
+void shared_container::copy(size_t i, shared_container const &other, size_t l, size_t r)
 {
     if (r <= l)
         throw std::invalid_argument(
                 "big_integer: container: in function copy(): left bound is larger than the right one"
         );
 
-    if (r - l == 1 && sz == 0) {
-        sz = 1;
-        data_short = *(other.data_long->begin() + l);
+    insert_range(i, other, l, r);
+}
+
+// inserts elements [l; r) of (other) before the i-th element
+void shared_container::insert_range(size_t i, shared_container const &other, size_t l, size_t r)
+{
+    if (r < l)
+        throw std::invalid_argument(
+                "big_integer: container: in function insert_range(): left bound is larger than the right one"
+        );
+
+    if (l == r)
+        return;
+
+    if (&other == this) {   // vector::insert does not take its own elements
+        shared_container temp(other);
+        insert_range(i, temp, l, r);
         return;
     }
 
-    if (sz == 1)
-        data_long = std::make_shared< std::vector<uint32_t> > (1, data_short);
-    else
-        real_copy();
+    uint32_t const* source = other.data();
+    to_long();
+    data_long->insert(data_long->begin() + i, source + l, source + r);
+    sz = data_long->size();
+    to_short();
+}
 
-    if (other.size() == 1)
-        data_long->insert(data_long->begin() + i, other.data_short);
-    else
-        std::copy(other.data_long->begin() + l,
-                  other.data_long->begin() + r,
-                  this->data_long->begin() + i
+void shared_container::append(shared_container const &other)
+{
+    insert_range(sz, other, 0, other.sz);
+}
+
+// erases elements [l; r)
+void shared_container::erase_range(size_t l, size_t r)
+{
+    if (r < l)
+        throw std::invalid_argument(
+                "big_integer: container: in function erase_range(): left bound is larger than the right one"
         );
 
+    if (l == r)
+        return;
+
+    to_long();
+    data_long->erase(data_long->begin() + l, data_long->begin() + r);
     sz = data_long->size();
+    to_short();
 }
 
-container& container::operator=(container const &other)
+shared_container& shared_container::operator=(shared_container const &other)
 {
     sz = other.sz;
     if (other.sz > 1)
@@ -121,14 +160,14 @@ container& container::operator=(container const &other)
     return *this;
 }
 
-uint32_t const& container::operator[](size_t i) const
+uint32_t const& shared_container::operator[](size_t i) const
 {
     if (sz == 1)
         return data_short;
     return (*data_long)[i];
 }
 
-uint32_t& container::operator[](size_t i)
+uint32_t& shared_container::operator[](size_t i)
 {
     if (sz == 1)
         return data_short;
@@ -137,7 +176,7 @@ uint32_t& container::operator[](size_t i)
     return (*data_long)[i];
 }
 
-uint32_t const& container::back() const
+uint32_t const& shared_container::back() const
 {
     if (sz == 0)
         throw std::out_of_range(
@@ -149,7 +188,7 @@ uint32_t const& container::back() const
     return data_long->back();
 }
 
-uint32_t& container::back()
+uint32_t& shared_container::back()
 {
     if (sz == 0)
         throw std::out_of_range(
@@ -162,7 +201,7 @@ uint32_t& container::back()
     return data_long->back();
 }
 
-void container::push_back(const uint32_t &value)
+void shared_container::push_back(const uint32_t &value)
 {
     if (sz == 0) {
         sz++;
@@ -171,14 +210,16 @@ void container::push_back(const uint32_t &value)
     }
 
     if (sz == 1)
-        data_long = std::make_shared< std::vector<uint32_t> >(1, data_short);
+        data_long = make_storage(1, data_short);
     else
         real_copy();
     sz++;
+    if (data_long->size() == data_long->capacity())
+        BIGINT_STAT(resize());
     data_long->push_back(value);
 }
 
-void container::pop_back()
+void shared_container::pop_back()
 {
     if (sz == 0)
         throw std::out_of_range(
@@ -197,13 +238,56 @@ void container::pop_back()
     return;
 }
 
-size_t container::size() const
+size_t shared_container::size() const
 {
     return sz;
 }
 
-inline void container::real_copy()
+uint32_t const* shared_container::data() const
+{
+    if (sz == 1)
+        return &data_short;
+    return sz ? data_long->data() : nullptr;
+}
+
+uint32_t* shared_container::data()
 {
-    if (!data_long.unique())
-        data_long = std::make_shared< std::vector<uint32_t> >(*data_long);
-}
\ No newline at end of file
+    if (sz == 1)
+        return &data_short;
+    if (sz == 0)
+        return nullptr;
+    real_copy();
+    return data_long->data();
+}
+
+shared_container::operator limb_span() const
+{
+    return limb_span(data(), sz);
+}
+
+inline void shared_container::real_copy()
+{
+    if (!data_long.unique()) {
+        BIGINT_STAT(unshare());
+        data_long = make_storage(*data_long);
+    }
+}
+
+// makes data long a unique vector of all elements
+inline void shared_container::to_long()
+{
+    if (sz > 1)
+        real_copy();
+    else
+        data_long = make_storage(sz, data_short);
+}
+
+// switches back to data short if there is at most one element
+inline void shared_container::to_short()
+{
+    if (sz > 1)
+        return;
+    if (sz == 1)
+        data_short = (*data_long)[0];
+    data_long.reset();
+}
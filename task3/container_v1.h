@@ -3,21 +3,26 @@
 
 #include <vector>
 #include <memory>
+#include "limb_allocator.h"
+#include "limb_span.h"
 
-struct container {
-    container();
-    container(size_t size);
-    container(size_t size, uint32_t value);
-    container(const container& other);
+struct shared_container {
+    shared_container();
+    shared_container(size_t size);
+    shared_container(size_t size, uint32_t value);
+    shared_container(const shared_container& other);
 
-    ~container();
+    ~shared_container();
 
     void assign(size_t size, uint32_t value);
     void resize(size_t size);
     void reserve(size_t size);
-    void copy(size_t i, container const& other, size_t l, size_t r);
+    void copy(size_t i, shared_container const& other, size_t l, size_t r);
+    void insert_range(size_t i, shared_container const& other, size_t l, size_t r);
+    void append(shared_container const& other);
+    void erase_range(size_t l, size_t r);
 
-    container& operator=(container const& other);
+    shared_container& operator=(shared_container const& other);
 
     uint32_t const& operator[](size_t i) const;
     uint32_t& operator[](size_t i);
@@ -29,14 +34,24 @@ struct container {
     void pop_back();
 
     size_t size() const;
+    uint32_t const* data() const;
+    uint32_t* data();                   // the data becomes unique
+
+    operator limb_span() const;
 
 private:
+    typedef std::vector< uint32_t, limb_std_allocator<uint32_t> > storage;
+
     size_t sz;
 
-    std::shared_ptr< std::vector<uint32_t> > data_long;
+    std::shared_ptr<storage> data_long;
     uint32_t data_short;
 
+    template <typename... Args>
+    static std::shared_ptr<storage> make_storage(Args const&... args);
     inline void real_copy();
+    inline void to_long();
+    inline void to_short();
 };
 
 #endif //BIGINT_CONTAINER_H
\ No newline at end of file
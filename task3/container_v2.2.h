@@ -1,20 +1,59 @@
 #ifndef BIGINT_CONTAINER_V2_H
 #define BIGINT_CONTAINER_V2_H
 
-struct container {
-    container();
-    container(size_t size);
-    container(size_t size, uint32_t value);
-    container(container const& other);
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <iostream>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+#include "bigint_arena.h"
+#include "bigint_stats.h"
+#include "limb_allocator.h"
+#include "limb_span.h"
 
-    ~container();
+// number of limbs stored inline, numbers of up to this size never touch the heap;
+// 256-bit values take 9 limbs and their sums 10, products of values up to 128 bits (5 limbs) take 10,
+// so 12 keeps them inline with some headroom; try other sizes with -DBIGINT_INLINE_LIMBS and big_integer_bench
+#ifndef BIGINT_INLINE_LIMBS
+#define BIGINT_INLINE_LIMBS 12
+#endif
+
+// long data of at least this many bytes is mapped directly from the kernel,
+// so it grows by remapping pages instead of copying
+#ifndef BIGINT_MMAP_THRESHOLD
+#define BIGINT_MMAP_THRESHOLD (4 << 20)
+#endif
+
+// define BIGINT_ATOMIC_REFCOUNT to share long data between threads:
+// owners are then counted atomically (relaxed increment, acq_rel decrement),
+// otherwise copies of one number must stay in one thread
+
+// (Alloc) provides long data below the mmap threshold, see limb_allocator.h
+template <size_t N, typename Alloc = BIGINT_DEFAULT_ALLOCATOR>
+struct basic_container {
+    static_assert(N >= 1, "big_integer: container: at least one limb must be stored inline");
+
+    basic_container();
+    basic_container(size_t size);
+    basic_container(size_t size, uint32_t value);
+    basic_container(basic_container const& other);
+
+    ~basic_container();
 
     void assign(size_t size, uint32_t value);
     void resize(size_t size);
     void reserve(size_t size);
-    void copy(size_t i, container const& other, size_t l, size_t r);
+    void shrink_to_fit();
+    void copy(size_t i, basic_container const& other, size_t l, size_t r);
+    void insert_range(size_t i, basic_container const& other, size_t l, size_t r);
+    void append(basic_container const& other);
+    void erase_range(size_t l, size_t r);
 
-    container& operator=(container const& other);
+    basic_container& operator=(basic_container const& other);
 
     uint32_t const& operator[](size_t i) const;
     uint32_t& operator[](size_t i);
@@ -26,19 +65,572 @@ struct container {
     void pop_back();
 
     size_t size() const;
+    uint32_t const* data() const;
+    uint32_t* data();                   // the data becomes unique
+
+    operator limb_span() const;
 
 private:
-    size_t sz, capacity = 1;
-    bool reserved = false;
+    size_t sz, capacity = N;    // capacity == N means that data short is used
     union {
-        uint32_t data_short;
-        uint32_t* data_long;
+        uint32_t data_short[N];
+        uint32_t* data_long;    // data_long[0] is the number of owners, limbs start from data_long[HEADER]
     };
 
-    inline void get_ownership();
-    inline void new_data_long(size_t sz, uint32_t value);
-    inline void delete_data_long();
-    inline void delete_data_long(uint32_t* ptr);
+    uint32_t* limbs();
+    uint32_t const* limbs() const;
+
+    static bool is_mapped(size_t capacity);
+    static size_t mapped_size(size_t capacity);
+    // long data starts with a header of one cache line (the owner counter and nothing else),
+    // limbs follow it, so they are aligned to LIMB_ALIGNMENT bytes like the whole buffer,
+    // and their storage is padded to a multiple of LIMB_ALIGNMENT, so full vectors can be read past (sz)
+    static const size_t HEADER = LIMB_ALIGNMENT / sizeof(uint32_t);
+    static const uint32_t ARENA = 1u << 31;    // set in the owner counter of arena data, it has a single owner
+
+    static size_t words(size_t capacity);
+    uint32_t* allocate(size_t capacity);
+    static void deallocate(uint32_t* ptr, size_t capacity);
+    void reallocate(size_t capacity);
+    void set_capacity(size_t capacity);
+    void prepare_write(size_t size);
+    void get_ownership();
+    static void subscribe(uint32_t* ptr);
+    static bool unsubscribe(uint32_t* ptr);
+    static bool is_shared(uint32_t* ptr);
+    static bool in_arena(uint32_t* ptr);
+    static void evacuate(void* owner);
+    void new_data_long(size_t sz, uint32_t value);
+    void delete_data_long();
+    void delete_data_long(uint32_t* ptr, size_t capacity);
 };
 
-#endif //BIGINT_CONTAINER_V2_H
\ No newline at end of file
+typedef basic_container<BIGINT_INLINE_LIMBS> container;
+
+template <size_t N, typename Alloc>
+basic_container<N, Alloc>::basic_container()
+        : sz(0)
+{}
+
+template <size_t N, typename Alloc>
+basic_container<N, Alloc>::basic_container(size_t sz)
+        : sz(sz)
+{
+    if (sz <= N)
+        std::fill_n(data_short, sz, 0);
+    else
+        new_data_long(sz, 0);
+}
+
+template <size_t N, typename Alloc>
+basic_container<N, Alloc>::basic_container(size_t sz, uint32_t value)
+        : sz(sz)
+{
+    if (sz <= N)
+        std::fill_n(data_short, sz, value);
+    else
+        new_data_long(sz, value);
+}
+
+template <size_t N, typename Alloc>
+basic_container<N, Alloc>::basic_container(basic_container const& other)
+        : sz(other.sz)
+{
+    if (other.sz <= N)              // short data is copied, even if other uses long one
+        std::copy_n(other.limbs(), sz, data_short);
+    else if (in_arena(other.data_long)) {
+        data_long = allocate(other.capacity);
+        std::copy_n(other.data_long + HEADER, sz, data_long + HEADER);
+        capacity = other.capacity;
+    } else {
+        subscribe(other.data_long); // no real copy
+        data_long = other.data_long;
+        capacity = other.capacity;
+    }
+}
+
+template <size_t N, typename Alloc>
+basic_container<N, Alloc>::~basic_container()
+{
+    if (capacity > N)
+        delete_data_long();
+}
+
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::assign(size_t sz, uint32_t value)
+{
+    if (capacity > N) {                 // data long is allocated already
+        if (sz <= capacity && sz >= (capacity >> 2) && !is_shared(data_long)) {
+            // it is ours, large enough and not too sparse, so reuse it
+            std::fill_n(data_long + HEADER, sz, value);
+            this->sz = sz;
+            return;
+        }
+        delete_data_long();             // otherwise prepare for new alloc
+    }
+
+    if (sz <= N)
+        std::fill_n(data_short, sz, value);
+    else
+        new_data_long(sz, value);
+
+    this->sz = sz;
+}
+
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::resize(size_t sz)
+{
+    if (sz == this->sz) // stupid user
+        return;
+
+    if (sz > capacity)                  // grow geometrically, so push_back is amortized O(1)
+        reallocate(std::max(sz, capacity << 1));
+    else if (capacity > N && sz < (capacity >> 2)) {
+        this->sz = std::min(this->sz, sz);  // shrink only if three quarters of the storage are unused
+        set_capacity(sz << 1);
+    }
+    else if (capacity > N && sz > this->sz)
+        get_ownership();                // we are going to write new zeros
+
+    if (sz > this->sz)
+        std::fill_n(limbs() + this->sz, sz - this->sz, 0);
+    this->sz = sz;
+}
+
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::reserve(size_t sz)
+{
+    if (sz > capacity)
+        reallocate(sz);
+}
+
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::shrink_to_fit()
+{
+    if (capacity > N && capacity != sz)
+        set_capacity(sz);
+}
+
+// the same as insert_range, but the range must not be empty
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::copy(size_t i, basic_container const& other, size_t l, size_t r)
+{
+    if (r <= l)
+        throw std::invalid_argument(
+                "big_integer: container: in function copy(): left bound is larger than the right one"
+        );
+
+    insert_range(i, other, l, r);
+}
+
+// inserts elements [l; r) of (other) before the i-th element,
+// (other) may be this container itself
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::insert_range(size_t i, basic_container const& other, size_t l, size_t r)
+{
+    if (r < l)
+        throw std::invalid_argument(
+                "big_integer: container: in function insert_range(): left bound is larger than the right one"
+        );
+
+    size_t count = r - l, temp = sz;
+    if (count == 0)
+        return;
+
+    uint32_t const* source = (&other == this) ? nullptr : other.limbs();   // (other) may share our long data,
+    prepare_write(sz + count);                                               // but it is not changed by unsharing
+    uint32_t* data = limbs();
+    std::memmove(data + i + count, data + i, (temp - i) * sizeof(uint32_t));
+
+    if (source != nullptr)
+        std::memcpy(data + i, source + l, count * sizeof(uint32_t));
+    else {
+        // the source was moved along with our elements: [l; i) stayed, [i; r) went (count) further
+        size_t before = (l < i) ? std::min(r, i) - l : 0;
+        std::memmove(data + i, data + l, before * sizeof(uint32_t));
+        std::memmove(data + i + before, data + std::max(l, i) + count, (count - before) * sizeof(uint32_t));
+    }
+    sz = temp + count;
+}
+
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::append(basic_container const& other)
+{
+    insert_range(sz, other, 0, other.sz);
+}
+
+// erases elements [l; r)
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::erase_range(size_t l, size_t r)
+{
+    if (r < l)
+        throw std::invalid_argument(
+                "big_integer: container: in function erase_range(): left bound is larger than the right one"
+        );
+
+    if (l == r)
+        return;
+
+    prepare_write(sz);
+    uint32_t* data = limbs();
+    std::memmove(data + l, data + r, (sz - r) * sizeof(uint32_t));
+    sz -= r - l;
+    if (capacity > N && sz < (capacity >> 2))
+        set_capacity(sz << 1);
+}
+
+template <size_t N, typename Alloc>
+basic_container<N, Alloc>& basic_container<N, Alloc>::operator=(basic_container const& other)
+{
+    if (this == &other)
+        return *this;
+
+    uint32_t* temp = (capacity > N) ? data_long : nullptr;  // free old long data after the copy,
+    size_t temp_capacity = capacity;                        // it may be the same as other's one
+    sz = other.sz;
+    capacity = N;
+    if (other.sz <= N)
+        std::copy_n(other.limbs(), sz, data_short);
+    else if (in_arena(other.data_long)) {
+        data_long = allocate(other.capacity);
+        std::copy_n(other.data_long + HEADER, sz, data_long + HEADER);
+        capacity = other.capacity;
+    } else {
+        subscribe(other.data_long);
+        data_long = other.data_long;    // no real copy
+        capacity = other.capacity;
+    }
+
+    if (temp != nullptr)
+        delete_data_long(temp, temp_capacity);
+
+    return *this;
+}
+
+template <size_t N, typename Alloc>
+uint32_t const& basic_container<N, Alloc>::operator[](size_t i) const
+{
+    if (capacity == N && i >= N)
+        throw std::out_of_range("big integer: container: in function operator[]");
+    return limbs()[i];
+}
+
+template <size_t N, typename Alloc>
+uint32_t& basic_container<N, Alloc>::operator[](size_t i)
+{
+    if (capacity == N) {
+        if (i >= N) throw std::out_of_range("big integer: container: in function operator[]");
+        return data_short[i];
+    }
+    get_ownership();
+    return data_long[i + HEADER];
+}
+
+template <size_t N, typename Alloc>
+uint32_t const& basic_container<N, Alloc>::back() const
+{
+    if (sz == 0)
+        throw std::out_of_range(
+                "big_integer: container: in function back(): no elements"
+        );
+
+    return limbs()[sz - 1];
+}
+
+template <size_t N, typename Alloc>
+uint32_t& basic_container<N, Alloc>::back()
+{
+    if (sz == 0)
+        throw std::out_of_range(
+                "big_integer: container: in function back(): no elements"
+        );
+
+    if (capacity == N)
+        return data_short[sz - 1];
+    get_ownership();
+    return data_long[sz - 1 + HEADER];
+}
+
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::push_back(uint32_t const& value)
+{
+    if (capacity == N && sz < N) {
+        data_short[sz++] = value;
+        return;
+    }
+
+    uint32_t temp = value;  // (value) may live in our storage
+    resize(sz + 1);
+    limbs()[sz - 1] = temp;
+}
+
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::pop_back()
+{
+    if (sz == 0)
+        throw std::out_of_range(
+                "big_integer: container: in function pop_back(): no elements"
+        );
+
+    sz--;
+    if (capacity > N && sz < (capacity >> 2))
+        set_capacity(sz << 1);
+}
+
+template <size_t N, typename Alloc>
+size_t basic_container<N, Alloc>::size() const
+{
+    return sz;
+}
+
+template <size_t N, typename Alloc>
+uint32_t const* basic_container<N, Alloc>::data() const
+{
+    return limbs();
+}
+
+template <size_t N, typename Alloc>
+uint32_t* basic_container<N, Alloc>::data()
+{
+    if (capacity != N)
+        get_ownership();
+    return limbs();
+}
+
+template <size_t N, typename Alloc>
+basic_container<N, Alloc>::operator limb_span() const
+{
+    return limb_span(limbs(), sz);
+}
+
+template <size_t N, typename Alloc>
+uint32_t* basic_container<N, Alloc>::limbs()
+{
+    return (capacity == N) ? data_short : data_long + HEADER;
+}
+
+template <size_t N, typename Alloc>
+uint32_t const* basic_container<N, Alloc>::limbs() const
+{
+    return (capacity == N) ? data_short : data_long + HEADER;
+}
+
+// size of long data for (capacity) limbs, in words
+template <size_t N, typename Alloc>
+size_t basic_container<N, Alloc>::words(size_t capacity)
+{
+    return HEADER + ((capacity + HEADER - 1) & ~(HEADER - 1));
+}
+
+template <size_t N, typename Alloc>
+bool basic_container<N, Alloc>::is_mapped(size_t capacity)
+{
+#ifdef __linux__
+    return words(capacity) * sizeof(uint32_t) >= BIGINT_MMAP_THRESHOLD;
+#else
+    return false;
+#endif
+}
+
+// size of the mapping which holds (capacity) limbs, rounded up to whole pages
+template <size_t N, typename Alloc>
+size_t basic_container<N, Alloc>::mapped_size(size_t capacity)
+{
+    const size_t PAGE = 4096;
+    return (words(capacity) * sizeof(uint32_t) + PAGE - 1) & ~(PAGE - 1);
+}
+
+// allocates long data for (capacity) limbs with a single owner, we are the owner if it is in an arena
+template <size_t N, typename Alloc>
+uint32_t* basic_container<N, Alloc>::allocate(size_t capacity)
+{
+    uint32_t* ptr;
+    bigint_arena* arena = bigint_arena::current();
+    try {
+        if (arena && !is_mapped(capacity)) {
+            ptr = arena->allocate(words(capacity), this, &evacuate);
+            ptr[0] = ARENA | 1;
+            BIGINT_STAT(allocation(words(capacity) * sizeof(uint32_t)));
+            return ptr;
+        }
+#ifdef __linux__
+        if (is_mapped(capacity)) {
+            void* mapped = mmap(nullptr, mapped_size(capacity), PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (mapped == MAP_FAILED)
+                throw std::bad_alloc();
+            ptr = static_cast<uint32_t*>(mapped);
+        } else
+#endif
+            ptr = Alloc::allocate(words(capacity));
+    } catch (std::bad_alloc& e) {
+        std::cout << "unsuccessful memory allocation: " << e.what() << std::endl;
+        throw e;
+    }
+    ptr[0] = 1;
+    BIGINT_STAT(allocation(words(capacity) * sizeof(uint32_t)));
+    return ptr;
+}
+
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::deallocate(uint32_t* ptr, size_t capacity)
+{
+    BIGINT_STAT(deallocation());
+#ifdef __linux__
+    if (is_mapped(capacity)) {
+        munmap(ptr, mapped_size(capacity));
+        return;
+    }
+#endif
+    Alloc::deallocate(ptr, words(capacity));
+}
+
+// moves the elements to a new long data of the given capacity, we become its unique owner
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::reallocate(size_t capacity)
+{
+    BIGINT_STAT(resize());
+#ifdef __linux__
+    if (this->capacity > N && is_mapped(this->capacity) && is_mapped(capacity) && !is_shared(data_long)) {
+        // the kernel moves the pages, nothing is copied
+        void* mapped = mremap(data_long, mapped_size(this->capacity), mapped_size(capacity), MREMAP_MAYMOVE);
+        if (mapped == MAP_FAILED) {
+            std::cout << "unsuccessful memory allocation: mremap failed" << std::endl;
+            throw std::bad_alloc();
+        }
+        data_long = static_cast<uint32_t*>(mapped);
+        this->capacity = capacity;
+        return;
+    }
+#endif
+
+    uint32_t* buffer = allocate(capacity);
+    std::copy_n(limbs(), sz, buffer + HEADER);
+
+    if (this->capacity > N)
+        delete_data_long(data_long, this->capacity);
+    data_long = buffer;
+    this->capacity = capacity;
+}
+
+// switches to data short if (capacity) allows it, reallocates long data otherwise
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::set_capacity(size_t capacity)
+{
+    if (capacity > N) {
+        reallocate(capacity);
+        return;
+    }
+
+    if (this->capacity > N) {
+        BIGINT_STAT(resize());
+        uint32_t* temp = data_long;     // data short shares memory with the pointer, so hold it
+        size_t temp_capacity = this->capacity;
+        std::copy_n(temp + HEADER, sz, data_short);
+        delete_data_long(temp, temp_capacity);
+        this->capacity = N;
+    }
+}
+
+// makes us a unique owner of storage for at least (size) elements, old elements are kept
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::prepare_write(size_t size)
+{
+    if (size > capacity)
+        reallocate(std::max(size, capacity << 1));
+    else if (capacity > N)
+        get_ownership();
+}
+
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::get_ownership()
+{
+    if (is_shared(data_long)) {     // if we are not a unique owner
+        BIGINT_STAT(unshare());
+        uint32_t* temp = data_long; // hold a copy pointer
+        data_long = allocate(capacity);
+
+        std::copy_n(temp + HEADER, sz, data_long + HEADER);   // copy data
+        delete_data_long(temp, capacity);   // unsubscribe only now: other owners may leave meanwhile
+    }
+}
+
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::subscribe(uint32_t* ptr)
+{
+#ifdef BIGINT_ATOMIC_REFCOUNT
+    __atomic_fetch_add(ptr, 1, __ATOMIC_RELAXED);   // we already own a reference, nothing to order
+#else
+    ptr[0]++;
+#endif
+}
+
+// returns true if we were the last owner
+template <size_t N, typename Alloc>
+bool basic_container<N, Alloc>::unsubscribe(uint32_t* ptr)
+{
+#ifdef BIGINT_ATOMIC_REFCOUNT
+    // release our writes to the owner who frees the data, acquire theirs if it is us
+    return __atomic_sub_fetch(ptr, 1, __ATOMIC_ACQ_REL) == 0;
+#else
+    return --ptr[0] == 0;
+#endif
+}
+
+template <size_t N, typename Alloc>
+bool basic_container<N, Alloc>::is_shared(uint32_t* ptr)
+{
+#ifdef BIGINT_ATOMIC_REFCOUNT
+    return (__atomic_load_n(ptr, __ATOMIC_ACQUIRE) & ~ARENA) > 1;
+#else
+    return (ptr[0] & ~ARENA) > 1;
+#endif
+}
+
+template <size_t N, typename Alloc>
+bool basic_container<N, Alloc>::in_arena(uint32_t* ptr)
+{
+#ifdef BIGINT_ATOMIC_REFCOUNT
+    return (__atomic_load_n(ptr, __ATOMIC_RELAXED) & ARENA) != 0;
+#else
+    return (ptr[0] & ARENA) != 0;
+#endif
+}
+
+// called by an ending arena for the container (owner) which still uses its data
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::evacuate(void* owner)
+{
+    basic_container* c = static_cast<basic_container*>(owner);
+    uint32_t* buffer = c->allocate(c->capacity);
+    std::copy_n(c->data_long + HEADER, c->sz, buffer + HEADER);
+    c->data_long = buffer;
+}
+
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::new_data_long(size_t sz, uint32_t value)
+{
+    capacity = sz << 1;
+    data_long = allocate(capacity);
+    std::fill_n(data_long + HEADER, sz, value);
+}
+
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::delete_data_long()
+{
+    delete_data_long(data_long, capacity);
+    capacity = N;
+}
+
+// all owners of long data have the same capacity
+template <size_t N, typename Alloc>
+void basic_container<N, Alloc>::delete_data_long(uint32_t* ptr, size_t capacity)
+{
+    if (in_arena(ptr)) {
+        BIGINT_STAT(deallocation());
+        bigint_arena::release(ptr);     // the memory itself is freed with the arena
+    } else if (unsubscribe(ptr))
+        deallocate(ptr, capacity);
+}
+
+#endif //BIGINT_CONTAINER_V2_H
@@ -0,0 +1,76 @@
+#ifndef BIGINT_CONTAINER_VECTOR_H
+#define BIGINT_CONTAINER_VECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <stdexcept>
+#include "limb_allocator.h"
+#include "bigint_stats.h"
+#include "limb_span.h"
+
+// plain std::vector storage over std::allocator (the one of task2): every copy is a deep copy,
+// no inline limbs, no sharing and no pool, so it is the baseline for other storages
+struct vector_container {
+    vector_container() {}
+    vector_container(size_t size) : limbs(size, 0) {}
+    vector_container(size_t size, uint32_t value) : limbs(size, value) {}
+
+    void assign(size_t size, uint32_t value) { limbs.assign(size, value); }
+    void resize(size_t size)
+    {
+        if (size > limbs.capacity())
+            BIGINT_STAT(resize());
+        limbs.resize(size, 0);
+    }
+
+    void reserve(size_t size) { limbs.reserve(size); }
+
+    uint32_t const& operator[](size_t i) const { return limbs[i]; }
+    uint32_t& operator[](size_t i) { return limbs[i]; }
+
+    uint32_t const& back() const
+    {
+        if (limbs.empty())
+            throw std::out_of_range(
+                    "big_integer: container: in function back(): no elements"
+            );
+        return limbs.back();
+    }
+
+    uint32_t& back()
+    {
+        if (limbs.empty())
+            throw std::out_of_range(
+                    "big_integer: container: in function back(): no elements"
+            );
+        return limbs.back();
+    }
+
+    void push_back(uint32_t const& value)
+    {
+        if (limbs.size() == limbs.capacity())
+            BIGINT_STAT(resize());
+        limbs.push_back(value);
+    }
+
+    void pop_back()
+    {
+        if (limbs.empty())
+            throw std::out_of_range(
+                    "big_integer: container: in function pop_back(): no elements"
+            );
+        limbs.pop_back();
+    }
+
+    size_t size() const { return limbs.size(); }
+    uint32_t const* data() const { return limbs.data(); }
+    uint32_t* data() { return limbs.data(); }
+
+    operator limb_span() const { return limb_span(limbs.data(), limbs.size()); }
+
+private:
+    std::vector< uint32_t, limb_std_allocator<uint32_t, plain_limb_allocator> > limbs;
+};
+
+#endif //BIGINT_CONTAINER_VECTOR_H
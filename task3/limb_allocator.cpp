@@ -0,0 +1,183 @@
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <new>
+#include "limb_allocator.h"
+
+// the pointer returned by operator new is kept right before the aligned buffer
+uint32_t* heap_limb_allocator::allocate(size_t size)
+{
+    char* raw = static_cast<char*>(::operator new(size * sizeof(uint32_t) + LIMB_ALIGNMENT));
+    char* aligned = raw + LIMB_ALIGNMENT - (reinterpret_cast<uintptr_t>(raw) & (LIMB_ALIGNMENT - 1));
+    reinterpret_cast<void**>(aligned)[-1] = raw;
+    return reinterpret_cast<uint32_t*>(aligned);
+}
+
+void heap_limb_allocator::deallocate(uint32_t* ptr, size_t)
+{
+    ::operator delete(reinterpret_cast<void**>(ptr)[-1]);
+}
+
+uint32_t* plain_limb_allocator::allocate(size_t size)
+{
+    return std::allocator<uint32_t>().allocate(size);
+}
+
+void plain_limb_allocator::deallocate(uint32_t* ptr, size_t size)
+{
+    std::allocator<uint32_t>().deallocate(ptr, size);
+}
+
+namespace {
+    const size_t MIN_CLASS = 4;         // 16 words
+    const size_t MAX_CLASS = 16;        // 64K words, larger buffers are not pooled
+    const size_t CLASSES = MAX_CLASS - MIN_CLASS + 1;
+    const size_t MAX_CACHED = 32;       // free buffers kept per size class
+
+    struct pool;
+
+    // header in front of every buffer of the pool allocator, it keeps buffers aligned
+    struct alignas(LIMB_ALIGNMENT) block {
+        pool* owner;                    // nullptr if the buffer is not pooled
+        block* next;
+        size_t size_class;
+    };
+
+    struct pool {
+        block* free[CLASSES] = {};
+        size_t cached[CLASSES] = {};
+        std::atomic<block*> remote{nullptr};    // buffers freed by other threads
+        pool* next_orphan = nullptr;
+    };
+
+    // pools of finished threads, the lock is taken only when threads start and finish
+    std::mutex orphans_lock;
+    pool* orphans = nullptr;
+
+    // (current) is trivially destructible, so it stays usable while thread_local destructors run;
+    // buffers are never freed back into an orphaned pool directly, they go to its remote list
+    thread_local pool* current = nullptr;
+    thread_local bool finished = false;
+
+    struct pool_owner {
+        pool* owned = nullptr;
+
+        ~pool_owner()
+        {
+            current = nullptr;
+            finished = true;
+            if (owned) {
+                std::lock_guard<std::mutex> lock(orphans_lock);
+                owned->next_orphan = orphans;
+                orphans = owned;
+            }
+        }
+    };
+    thread_local pool_owner owner;
+
+    // pool of the calling thread, nullptr when the thread is finishing
+    pool* local_pool()
+    {
+        if (current || finished)
+            return current;
+
+        pool* p = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(orphans_lock);
+            if (orphans) {
+                p = orphans;
+                orphans = p->next_orphan;
+            }
+        }
+        if (!p)
+            p = new pool();             // pools are never freed, their buffers may outlive threads
+        owner.owned = p;
+        current = p;
+        return p;
+    }
+
+    size_t size_class(size_t size)
+    {
+        size_t cls = MIN_CLASS;
+        while (cls <= MAX_CLASS && (size_t(1) << cls) < size)
+            cls++;
+        return cls;
+    }
+
+    block* new_block(size_t words)
+    {
+        return reinterpret_cast<block*>(heap_limb_allocator::allocate(sizeof(block) / sizeof(uint32_t) + words));
+    }
+
+    void free_block(block* b)
+    {
+        heap_limb_allocator::deallocate(reinterpret_cast<uint32_t*>(b), 0);
+    }
+
+    void put(pool* p, block* b)
+    {
+        size_t i = b->size_class - MIN_CLASS;
+        if (p->cached[i] >= MAX_CACHED) {
+            free_block(b);
+            return;
+        }
+        b->next = p->free[i];
+        p->free[i] = b;
+        p->cached[i]++;
+    }
+
+    // moves buffers freed by other threads to the free lists of (p)
+    void collect(pool* p)
+    {
+        block* b = p->remote.exchange(nullptr, std::memory_order_acquire);
+        while (b) {
+            block* next = b->next;
+            put(p, b);
+            b = next;
+        }
+    }
+}
+
+uint32_t* pool_limb_allocator::allocate(size_t size)
+{
+    size_t cls = size_class(size);
+    pool* p = cls <= MAX_CLASS ? local_pool() : nullptr;
+
+    block* b = nullptr;
+    if (p) {
+        size_t i = cls - MIN_CLASS;
+        if (!p->free[i])
+            collect(p);
+        b = p->free[i];
+        if (b) {
+            p->free[i] = b->next;
+            p->cached[i]--;
+        }
+    }
+
+    if (!b) {
+        size_t words = p ? (size_t(1) << cls) : size;
+        b = new_block(words);
+        b->owner = p;
+        b->size_class = cls;
+    }
+    return reinterpret_cast<uint32_t*>(b + 1);
+}
+
+void pool_limb_allocator::deallocate(uint32_t* ptr, size_t)
+{
+    block* b = reinterpret_cast<block*>(ptr) - 1;
+    pool* p = b->owner;
+    if (!p) {
+        free_block(b);
+        return;
+    }
+    if (p == current) {
+        put(p, b);
+        return;
+    }
+
+    b->next = p->remote.load(std::memory_order_relaxed);
+    while (!p->remote.compare_exchange_weak(b->next, b, std::memory_order_release, std::memory_order_relaxed))
+        ;
+}
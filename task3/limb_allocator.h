@@ -0,0 +1,85 @@
+#ifndef LIMB_ALLOCATOR_H
+#define LIMB_ALLOCATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include "bigint_stats.h"
+
+// allocators of limb storage: they are stateless, so containers keep no allocator object,
+// sizes are counted in uint32_t words, both functions throw std::bad_alloc on failure
+
+// all buffers are aligned to this many bytes (a cache line, an AVX-512 vector)
+const size_t LIMB_ALIGNMENT = 64;
+
+// global operator new / delete, over-allocated to get the alignment
+struct heap_limb_allocator {
+    static uint32_t* allocate(size_t size);
+    static void deallocate(uint32_t* ptr, size_t size);
+};
+
+// std::allocator: no alignment above that of uint32_t and no reuse, what std::vector of task2 used
+struct plain_limb_allocator {
+    static uint32_t* allocate(size_t size);
+    static void deallocate(uint32_t* ptr, size_t size);
+};
+
+// thread-local pool with power-of-two size classes:
+// freed buffers are kept for reuse by the thread which allocated them,
+// buffers freed by other threads come back through a lock-free list,
+// pools of finished threads are adopted by new threads
+struct pool_limb_allocator {
+    static uint32_t* allocate(size_t size);
+    static void deallocate(uint32_t* ptr, size_t size);
+};
+
+#ifndef BIGINT_DEFAULT_ALLOCATOR
+#define BIGINT_DEFAULT_ALLOCATOR pool_limb_allocator
+#endif
+
+// adapts a limb allocator to the standard allocator interface, for std::vector and std::allocate_shared
+template <typename T, typename Alloc = BIGINT_DEFAULT_ALLOCATOR>
+struct limb_std_allocator {
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind {
+        typedef limb_std_allocator<U, Alloc> other;
+    };
+
+    limb_std_allocator() = default;
+    template <typename U>
+    limb_std_allocator(limb_std_allocator<U, Alloc> const&) {}
+
+    T* allocate(size_t n)
+    {
+        T* ptr = reinterpret_cast<T*>(Alloc::allocate(words(n)));
+        BIGINT_STAT(allocation(words(n) * sizeof(uint32_t)));
+        return ptr;
+    }
+
+    void deallocate(T* ptr, size_t n)
+    {
+        BIGINT_STAT(deallocation());
+        Alloc::deallocate(reinterpret_cast<uint32_t*>(ptr), words(n));
+    }
+
+private:
+    static size_t words(size_t n)
+    {
+        return (n * sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    }
+};
+
+template <typename T, typename U, typename Alloc>
+bool operator==(limb_std_allocator<T, Alloc> const&, limb_std_allocator<U, Alloc> const&)
+{
+    return true;
+}
+
+template <typename T, typename U, typename Alloc>
+bool operator!=(limb_std_allocator<T, Alloc> const&, limb_std_allocator<U, Alloc> const&)
+{
+    return false;
+}
+
+#endif // LIMB_ALLOCATOR_H
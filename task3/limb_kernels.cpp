@@ -0,0 +1,613 @@
+#include <algorithm>
+#include <cstring>
+#include "limb_kernels.h"
+
+// vector kernels are built with target attributes and chosen at run time,
+// define BIGINT_NO_SIMD to build only the scalar ones, BIGINT_NO_AVX512 to skip AVX-512
+#if !defined(BIGINT_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BIGINT_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
+    const int32_t POWER = 30;
+    const uint32_t MASK = (1u << POWER) - 1;
+
+    // balanced operands shorter than this are multiplied in O(n * m)
+    const size_t KARATSUBA_THRESHOLD = 32;
+
+    // kernels over (n) limbs of equal-sized arrays, (out) may be the same as (x)
+
+    // out = x + y + carry, returns the carry
+    uint32_t add_n_scalar(uint32_t const* x, uint32_t const* y, uint32_t* out, size_t n, uint32_t carry)
+    {
+        for (size_t i = 0; i < n; i++) {
+            uint32_t sum = x[i] + y[i] + carry;
+            out[i] = sum & MASK;
+            carry = sum >> POWER;
+        }
+        return carry;
+    }
+
+    // out = x - y - borrow, returns the borrow
+    uint32_t sub_n_scalar(uint32_t const* x, uint32_t const* y, uint32_t* out, size_t n, uint32_t borrow)
+    {
+        for (size_t i = 0; i < n; i++) {
+            uint32_t diff = x[i] - y[i] - borrow;
+            out[i] = diff & MASK;
+            borrow = diff >> 31;
+        }
+        return borrow;
+    }
+
+    // compares x and y from the highest limb
+    int compare_n_scalar(uint32_t const* x, uint32_t const* y, size_t n)
+    {
+        for (size_t i = n; i-- > 0; )
+            if (x[i] != y[i])
+                return x[i] < y[i] ? -1 : 1;
+        return 0;
+    }
+
+    void and_n_scalar(uint32_t const* x, uint32_t const* y, uint32_t* out, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+            out[i] = x[i] & y[i];
+    }
+
+    void or_n_scalar(uint32_t const* x, uint32_t const* y, uint32_t* out, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+            out[i] = x[i] | y[i];
+    }
+
+    void xor_n_scalar(uint32_t const* x, uint32_t const* y, uint32_t* out, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+            out[i] = x[i] ^ y[i];
+    }
+
+    void not_n_scalar(uint32_t const* x, uint32_t* out, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+            out[i] = ~x[i] & MASK;
+    }
+
+#ifdef BIGINT_X86_KERNELS
+    // additions and subtractions resolve carries of a whole vector at once (carry-lookahead):
+    // (g) has bits of lanes which generate a carry, (p) of lanes which pass an incoming carry on,
+    // then ((g << 1) | carry) + p flips exactly the bits of p-runs reached by a carry,
+    // so xor with (p) gives the lanes which get a carry, and the bit past the last lane is the carry out
+
+    __attribute__((target("avx2")))
+    uint32_t add_n_avx2(uint32_t const* x, uint32_t const* y, uint32_t* out, size_t n, uint32_t carry)
+    {
+        __m256i const mask = _mm256_set1_epi32(MASK), one = _mm256_set1_epi32(1);
+        __m256i const lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i sum = _mm256_add_epi32(_mm256_loadu_si256((__m256i const*) (x + i)),
+                                           _mm256_loadu_si256((__m256i const*) (y + i)));
+            __m256i low = _mm256_and_si256(sum, mask);
+            uint32_t g = (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_slli_epi32(sum, 1)));
+            uint32_t p = (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(low, mask)));
+            uint32_t c = ((g << 1) | carry) + p;
+            carry = c >> 8;
+            __m256i in = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32((int) (c ^ p)), lanes), one);
+            _mm256_storeu_si256((__m256i*) (out + i), _mm256_and_si256(_mm256_add_epi32(low, in), mask));
+        }
+        return add_n_scalar(x + i, y + i, out + i, n - i, carry);
+    }
+
+    __attribute__((target("avx2")))
+    uint32_t sub_n_avx2(uint32_t const* x, uint32_t const* y, uint32_t* out, size_t n, uint32_t borrow)
+    {
+        __m256i const mask = _mm256_set1_epi32(MASK), one = _mm256_set1_epi32(1);
+        __m256i const lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i diff = _mm256_sub_epi32(_mm256_loadu_si256((__m256i const*) (x + i)),
+                                            _mm256_loadu_si256((__m256i const*) (y + i)));
+            __m256i low = _mm256_and_si256(diff, mask);
+            uint32_t g = (uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(diff));
+            uint32_t p = (uint32_t) _mm256_movemask_ps(
+                    _mm256_castsi256_ps(_mm256_cmpeq_epi32(low, _mm256_setzero_si256())));
+            uint32_t c = ((g << 1) | borrow) + p;
+            borrow = c >> 8;
+            __m256i in = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32((int) (c ^ p)), lanes), one);
+            _mm256_storeu_si256((__m256i*) (out + i), _mm256_and_si256(_mm256_sub_epi32(low, in), mask));
+        }
+        return sub_n_scalar(x + i, y + i, out + i, n - i, borrow);
+    }
+
+    __attribute__((target("avx2")))
+    int compare_n_avx2(uint32_t const* x, uint32_t const* y, size_t n)
+    {
+        size_t i = n;
+        for (; i >= 8; i -= 8) {
+            __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((__m256i const*) (x + i - 8)),
+                                            _mm256_loadu_si256((__m256i const*) (y + i - 8)));
+            uint32_t diff = ~(uint32_t) _mm256_movemask_ps(_mm256_castsi256_ps(eq)) & 0xFF;
+            if (diff) {
+                size_t j = i - 8 + (31 - __builtin_clz(diff));
+                return x[j] < y[j] ? -1 : 1;
+            }
+        }
+        return compare_n_scalar(x, y, i);
+    }
+
+#define BIGINT_BITWISE_AVX2(name, op, scalar)                                                   \
+    __attribute__((target("avx2")))                                                             \
+    void name(uint32_t const* x, uint32_t const* y, uint32_t* out, size_t n)                    \
+    {                                                                                           \
+        size_t i = 0;                                                                           \
+        for (; i + 8 <= n; i += 8)                                                              \
+            _mm256_storeu_si256((__m256i*) (out + i),                                           \
+                                op(_mm256_loadu_si256((__m256i const*) (x + i)),                \
+                                   _mm256_loadu_si256((__m256i const*) (y + i))));              \
+        scalar(x + i, y + i, out + i, n - i);                                                   \
+    }
+
+    BIGINT_BITWISE_AVX2(and_n_avx2, _mm256_and_si256, and_n_scalar)
+    BIGINT_BITWISE_AVX2(or_n_avx2, _mm256_or_si256, or_n_scalar)
+    BIGINT_BITWISE_AVX2(xor_n_avx2, _mm256_xor_si256, xor_n_scalar)
+#undef BIGINT_BITWISE_AVX2
+
+    __attribute__((target("avx2")))
+    void not_n_avx2(uint32_t const* x, uint32_t* out, size_t n)
+    {
+        __m256i const mask = _mm256_set1_epi32(MASK);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8)
+            _mm256_storeu_si256((__m256i*) (out + i),
+                                _mm256_xor_si256(_mm256_loadu_si256((__m256i const*) (x + i)), mask));
+        not_n_scalar(x + i, out + i, n - i);
+    }
+
+#ifndef BIGINT_NO_AVX512
+    // AVX-512 kernels handle the last incomplete vector with masked loads and stores
+
+    __attribute__((target("avx512f")))
+    inline __mmask16 lanes_mask(size_t count)
+    {
+        return count >= 16 ? (__mmask16) 0xFFFF : (__mmask16) ((1u << count) - 1);
+    }
+
+    __attribute__((target("avx512f")))
+    uint32_t add_n_avx512(uint32_t const* x, uint32_t const* y, uint32_t* out, size_t n, uint32_t carry)
+    {
+        __m512i const mask = _mm512_set1_epi32(MASK), high = _mm512_set1_epi32(1 << POWER);
+        __m512i const one = _mm512_set1_epi32(1);
+        for (size_t i = 0; i < n; i += 16) {
+            size_t width = std::min(n - i, (size_t) 16);
+            __mmask16 valid = lanes_mask(width);
+            __m512i sum = _mm512_add_epi32(_mm512_maskz_loadu_epi32(valid, x + i),
+                                           _mm512_maskz_loadu_epi32(valid, y + i));
+            __m512i low = _mm512_and_si512(sum, mask);
+            uint32_t g = _mm512_test_epi32_mask(sum, high);
+            uint32_t p = _mm512_mask_cmpeq_epi32_mask(valid, low, mask);
+            uint32_t c = ((g << 1) | carry) + p;
+            carry = c >> width;
+            __m512i res = _mm512_and_si512(_mm512_mask_add_epi32(low, (__mmask16) (c ^ p), low, one), mask);
+            _mm512_mask_storeu_epi32(out + i, valid, res);
+        }
+        return carry;
+    }
+
+    __attribute__((target("avx512f")))
+    uint32_t sub_n_avx512(uint32_t const* x, uint32_t const* y, uint32_t* out, size_t n, uint32_t borrow)
+    {
+        __m512i const mask = _mm512_set1_epi32(MASK), zero = _mm512_setzero_si512();
+        __m512i const one = _mm512_set1_epi32(1);
+        for (size_t i = 0; i < n; i += 16) {
+            size_t width = std::min(n - i, (size_t) 16);
+            __mmask16 valid = lanes_mask(width);
+            __m512i diff = _mm512_sub_epi32(_mm512_maskz_loadu_epi32(valid, x + i),
+                                            _mm512_maskz_loadu_epi32(valid, y + i));
+            __m512i low = _mm512_and_si512(diff, mask);
+            uint32_t g = _mm512_cmplt_epi32_mask(diff, zero);
+            uint32_t p = _mm512_mask_cmpeq_epi32_mask(valid, low, zero);
+            uint32_t c = ((g << 1) | borrow) + p;
+            borrow = c >> width;
+            __m512i res = _mm512_and_si512(_mm512_mask_sub_epi32(low, (__mmask16) (c ^ p), low, one), mask);
+            _mm512_mask_storeu_epi32(out + i, valid, res);
+        }
+        return borrow;
+    }
+
+    __attribute__((target("avx512f")))
+    int compare_n_avx512(uint32_t const* x, uint32_t const* y, size_t n)
+    {
+        for (size_t i = n; i > 0; ) {
+            size_t width = std::min(i, (size_t) 16);
+            i -= width;
+            __mmask16 valid = lanes_mask(width);
+            uint32_t diff = _mm512_mask_cmpneq_epi32_mask(valid, _mm512_maskz_loadu_epi32(valid, x + i),
+                                                          _mm512_maskz_loadu_epi32(valid, y + i));
+            if (diff) {
+                size_t j = i + (31 - __builtin_clz(diff));
+                return x[j] < y[j] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+#define BIGINT_BITWISE_AVX512(name, op)                                                         \
+    __attribute__((target("avx512f")))                                                          \
+    void name(uint32_t const* x, uint32_t const* y, uint32_t* out, size_t n)                    \
+    {                                                                                           \
+        for (size_t i = 0; i < n; i += 16) {                                                    \
+            __mmask16 valid = lanes_mask(n - i);                                                \
+            _mm512_mask_storeu_epi32(out + i, valid, op(_mm512_maskz_loadu_epi32(valid, x + i), \
+                                                        _mm512_maskz_loadu_epi32(valid, y + i))); \
+        }                                                                                       \
+    }
+
+    BIGINT_BITWISE_AVX512(and_n_avx512, _mm512_and_si512)
+    BIGINT_BITWISE_AVX512(or_n_avx512, _mm512_or_si512)
+    BIGINT_BITWISE_AVX512(xor_n_avx512, _mm512_xor_si512)
+#undef BIGINT_BITWISE_AVX512
+
+    __attribute__((target("avx512f")))
+    void not_n_avx512(uint32_t const* x, uint32_t* out, size_t n)
+    {
+        __m512i const mask = _mm512_set1_epi32(MASK);
+        for (size_t i = 0; i < n; i += 16) {
+            __mmask16 valid = lanes_mask(n - i);
+            _mm512_mask_storeu_epi32(out + i, valid, _mm512_xor_si512(_mm512_maskz_loadu_epi32(valid, x + i), mask));
+        }
+    }
+#endif // BIGINT_NO_AVX512
+#endif // BIGINT_X86_KERNELS
+
+    struct kernel_table {
+        uint32_t (*add_n)(uint32_t const*, uint32_t const*, uint32_t*, size_t, uint32_t);
+        uint32_t (*sub_n)(uint32_t const*, uint32_t const*, uint32_t*, size_t, uint32_t);
+        int (*compare_n)(uint32_t const*, uint32_t const*, size_t);
+        void (*and_n)(uint32_t const*, uint32_t const*, uint32_t*, size_t);
+        void (*or_n)(uint32_t const*, uint32_t const*, uint32_t*, size_t);
+        void (*xor_n)(uint32_t const*, uint32_t const*, uint32_t*, size_t);
+        void (*not_n)(uint32_t const*, uint32_t*, size_t);
+    };
+
+    kernel_table select_kernels()
+    {
+#ifdef BIGINT_X86_KERNELS
+        __builtin_cpu_init();           // we may be called by static initializers
+#ifndef BIGINT_NO_AVX512
+        if (__builtin_cpu_supports("avx512f"))
+            return {add_n_avx512, sub_n_avx512, compare_n_avx512,
+                    and_n_avx512, or_n_avx512, xor_n_avx512, not_n_avx512};
+#endif
+        if (__builtin_cpu_supports("avx2"))
+            return {add_n_avx2, sub_n_avx2, compare_n_avx2,
+                    and_n_avx2, or_n_avx2, xor_n_avx2, not_n_avx2};
+#endif
+        return {add_n_scalar, sub_n_scalar, compare_n_scalar,
+                and_n_scalar, or_n_scalar, xor_n_scalar, not_n_scalar};
+    }
+
+    // chosen once, on the first use
+    kernel_table const& kernels()
+    {
+        static const kernel_table table = select_kernels();
+        return table;
+    }
+
+    size_t significant(limb_span a)
+    {
+        size_t size = a.size;
+        while (size > 0 && a.data[size - 1] == 0)
+            size--;
+        return size;
+    }
+
+    // out[0; size) = x[0; size) + carry, returns the carry
+    uint32_t add_carry(uint32_t const* x, uint32_t* out, size_t size, uint32_t carry)
+    {
+        size_t i = 0;
+        for (; carry != 0 && i < size; i++) {
+            uint32_t sum = x[i] + carry;
+            out[i] = sum & MASK;
+            carry = sum >> POWER;
+        }
+        if (out != x)
+            std::copy(x + i, x + size, out + i);
+        return carry;
+    }
+
+    // out[0; size) = x[0; size) - borrow, returns the borrow
+    uint32_t sub_borrow(uint32_t const* x, uint32_t* out, size_t size, uint32_t borrow)
+    {
+        size_t i = 0;
+        for (; borrow != 0 && i < size; i++) {
+            uint32_t diff = x[i] - borrow;
+            out[i] = diff & MASK;
+            borrow = diff >> 31;
+        }
+        if (out != x)
+            std::copy(x + i, x + size, out + i);
+        return borrow;
+    }
+
+    // dst[0; size) += a, the carry out of (size) limbs is lost
+    void add_to(uint32_t* dst, size_t size, limb_span a)
+    {
+        uint32_t carry = kernels().add_n(dst, a.data, dst, a.size, 0);
+        add_carry(dst + a.size, dst + a.size, size - a.size, carry);
+    }
+
+    // dst[0; size) -= a, dst >= a
+    void sub_from(uint32_t* dst, size_t size, limb_span a)
+    {
+        uint32_t borrow = kernels().sub_n(dst, a.data, dst, a.size, 0);
+        sub_borrow(dst + a.size, dst + a.size, size - a.size, borrow);
+    }
+
+    // out[0; n) = x[0; n) << shift, shift < POWER, returns the bits shifted out
+    uint32_t shl_bits(uint32_t const* x, size_t n, int shift, uint32_t* out)
+    {
+        uint32_t carry = 0;
+        for (size_t i = 0; i < n; i++) {
+            uint64_t cur = ((uint64_t) x[i] << shift) | carry;
+            out[i] = (uint32_t) (cur & MASK);
+            carry = (uint32_t) (cur >> POWER);
+        }
+        return carry;
+    }
+
+    // u[0; k] -= q * v[0; k), returns true if the result is negative, it is taken modulo BASE^(k + 1) then
+    bool sub_mul(uint32_t* u, uint32_t const* v, size_t k, uint64_t q)
+    {
+        uint64_t carry = 0;
+        uint32_t borrow = 0;
+        for (size_t i = 0; i < k; i++) {
+            uint64_t product = q * v[i] + carry;
+            carry = product >> POWER;
+            uint32_t diff = u[i] - (uint32_t) (product & MASK) - borrow;
+            u[i] = diff & MASK;
+            borrow = diff >> 31;
+        }
+        uint64_t diff = (uint64_t) u[k] - carry - borrow;
+        u[k] = (uint32_t) diff & MASK;
+        return (diff >> 63) != 0;
+    }
+
+    void mul_basecase(limb_span a, limb_span b, uint32_t* out)
+    {
+        std::fill(out, out + a.size + b.size, 0);
+        for (size_t i = 0; i < a.size; i++) {
+            uint64_t ai = a.data[i];
+            if (ai == 0)
+                continue;
+            uint64_t carry = 0;
+            for (size_t j = 0; j < b.size; j++) {
+                uint64_t cur = ai * b.data[j] + out[i + j] + carry;
+                out[i + j] = (uint32_t) (cur & MASK);
+                carry = cur >> POWER;
+            }
+            out[i + b.size] = (uint32_t) carry;
+        }
+    }
+}
+
+int compare_limbs(limb_span a, limb_span b)
+{
+    size_t a_size = significant(a), b_size = significant(b);
+    if (a_size != b_size)
+        return a_size < b_size ? -1 : 1;
+    return kernels().compare_n(a.data, b.data, a_size);
+}
+
+size_t add_limbs(limb_span a, limb_span b, uint32_t* out)
+{
+    if (a.size < b.size)
+        std::swap(a, b);
+    uint32_t carry = kernels().add_n(a.data, b.data, out, b.size, 0);
+    carry = add_carry(a.data + b.size, out + b.size, a.size - b.size, carry);
+    if (carry != 0) {
+        out[a.size] = carry;
+        return a.size + 1;
+    }
+    return a.size;
+}
+
+size_t sub_limbs(limb_span a, limb_span b, uint32_t* out)
+{
+    size_t b_size = significant(b);
+    uint32_t borrow = kernels().sub_n(a.data, b.data, out, b_size, 0);
+    sub_borrow(a.data + b_size, out + b_size, a.size - b_size, borrow);
+
+    size_t size = significant(limb_span(out, a.size));
+    if (size == 0) {
+        out[0] = 0;
+        return 1;
+    }
+    return size;
+}
+
+void and_limbs(limb_span a, limb_span b, uint32_t* out)
+{
+    kernels().and_n(a.data, b.data, out, a.size);
+}
+
+void or_limbs(limb_span a, limb_span b, uint32_t* out)
+{
+    kernels().or_n(a.data, b.data, out, a.size);
+}
+
+void xor_limbs(limb_span a, limb_span b, uint32_t* out)
+{
+    kernels().xor_n(a.data, b.data, out, a.size);
+}
+
+void not_limbs(limb_span a, uint32_t* out)
+{
+    kernels().not_n(a.data, out, a.size);
+}
+
+size_t mul_scratch_size(size_t size)
+{
+    if (size < KARATSUBA_THRESHOLD)
+        return 0;
+    return 2 * size + 8 + mul_scratch_size(size / 2 + 2);
+}
+
+void mul_limbs(limb_span a, limb_span b, uint32_t* out, uint32_t* scratch)
+{
+    if (a.size < b.size)
+        std::swap(a, b);
+    size_t n = a.size, k = b.size;
+    if (k < KARATSUBA_THRESHOLD) {
+        mul_basecase(a, b, out);
+        return;
+    }
+    if (n >= 2 * k) {
+        // multiply by pieces of (k) limbs, every product goes to (scratch) first
+        std::fill(out, out + n + k, 0);
+        for (size_t i = 0; i < n; i += k) {
+            limb_span piece = a.subspan(i, k);
+            mul_limbs(piece, b, scratch, scratch + 2 * k);
+            add_to(out + i, n + k - i, limb_span(scratch, piece.size + k));
+        }
+        return;
+    }
+
+    // a = a1 * BASE^m + a0, b = b1 * BASE^m + b0, both high parts are not empty
+    size_t m = n / 2;
+    limb_span a0 = a.subspan(0, m), a1 = a.subspan(m, n - m);
+    limb_span b0 = b.subspan(0, m), b1 = b.subspan(m, k - m);
+
+    mul_limbs(a0, b0, out, scratch);
+    mul_limbs(a1, b1, out + 2 * m, scratch);
+
+    // (a0 + a1) * (b0 + b1) - a0 * b0 - a1 * b1 = a0 * b1 + a1 * b0
+    uint32_t* sa = scratch;
+    size_t sa_size = add_limbs(a0, a1, sa);
+    uint32_t* sb = sa + sa_size;
+    size_t sb_size = add_limbs(b0, b1, sb);
+    uint32_t* middle = sb + sb_size;
+    size_t middle_size = sa_size + sb_size;
+    mul_limbs(limb_span(sa, sa_size), limb_span(sb, sb_size), middle, middle + middle_size);
+    sub_from(middle, middle_size, limb_span(out, 2 * m));
+    sub_from(middle, middle_size, limb_span(out + 2 * m, n + k - 2 * m));
+
+    add_to(out + m, n + k - m, limb_span(middle, std::min(middle_size, n + k - m)));
+}
+
+uint32_t mul_1_limbs(limb_span a, uint32_t b, uint32_t carry, uint32_t* out)
+{
+    uint64_t cur = carry;
+    for (size_t i = 0; i < a.size; i++) {
+        cur += (uint64_t) a.data[i] * b;
+        out[i] = (uint32_t) (cur & MASK);
+        cur >>= POWER;
+    }
+    return (uint32_t) cur;
+}
+
+uint32_t div_1_limbs(limb_span a, uint32_t b, uint32_t* out)
+{
+    uint64_t rem = 0;
+    for (size_t i = a.size; i-- > 0; ) {
+        uint64_t cur = (rem << POWER) | a.data[i];
+        out[i] = (uint32_t) (cur / b);
+        rem = cur % b;
+    }
+    return (uint32_t) rem;
+}
+
+size_t div_scratch_size(size_t a_size, size_t b_size)
+{
+    return b_size > 1 ? a_size + b_size + 1 : 0;
+}
+
+// Knuth's algorithm D: both operands are shifted so that the highest bit of the divisor is set,
+// then every quotient limb is estimated by the two highest limbs of the rest and the divisor,
+// the estimate is at most one too large after the correction by the third limbs
+void div_limbs(limb_span a, limb_span b, uint32_t* quotient, uint32_t* remainder, uint32_t* scratch)
+{
+    size_t n = significant(a), k = significant(b);
+    std::fill(quotient, quotient + a.size - b.size + 1, 0);
+    std::fill(remainder, remainder + b.size, 0);
+    if (n < k) {
+        std::copy(a.data, a.data + n, remainder);
+        return;
+    }
+    if (k == 1) {
+        remainder[0] = div_1_limbs(limb_span(a.data, n), b.data[0], quotient);
+        return;
+    }
+
+    int shift = __builtin_clz(b.data[k - 1]) - (32 - POWER);
+    uint32_t* u = scratch;                  // n + 1 limbs
+    uint32_t* v = scratch + n + 1;          // k limbs
+    u[n] = shl_bits(a.data, n, shift, u);
+    shl_bits(b.data, k, shift, v);
+
+    uint64_t v1 = v[k - 1], v2 = v[k - 2];
+    for (size_t j = n - k + 1; j-- > 0; ) {
+        uint64_t top = ((uint64_t) u[j + k] << POWER) | u[j + k - 1];
+        uint64_t q = top / v1, r = top % v1;
+        while (q > MASK || q * v2 > ((r << POWER) | u[j + k - 2])) {
+            q--;
+            r += v1;
+            if (r > MASK)
+                break;
+        }
+        if (sub_mul(u + j, v, k, q)) {      // q was one too large, add the divisor back
+            q--;
+            uint32_t carry = kernels().add_n(u + j, v, u + j, k, 0);
+            u[j + k] = (u[j + k] + carry) & MASK;
+        }
+        quotient[j] = (uint32_t) q;
+    }
+
+    // u[k; n] are zeros now
+    for (size_t i = 0; i < k; i++)
+        remainder[i] = ((u[i] >> shift) | (u[i + 1] << (POWER - shift))) & MASK;
+}
+
+size_t shl_limbs(limb_span a, size_t shift, uint32_t* out)
+{
+    size_t n = shift / POWER, r = shift % POWER;
+    std::fill(out, out + n, 0);
+    uint32_t carry = 0;
+    for (size_t i = 0; i < a.size; i++) {
+        uint64_t cur = ((uint64_t) a.data[i] << r) | carry;
+        out[i + n] = (uint32_t) (cur & MASK);
+        carry = (uint32_t) (cur >> POWER);
+    }
+    out[a.size + n] = carry;
+    size_t size = significant(limb_span(out, a.size + n + 1));
+    return std::max(size, (size_t) 1);
+}
+
+size_t shr_limbs(limb_span a, size_t shift, uint32_t* out)
+{
+    size_t n = shift / POWER, r = shift % POWER;
+    if (n >= a.size) {
+        out[0] = 0;
+        return 1;
+    }
+    size_t size = a.size - n;
+    for (size_t i = 0; i < size; i++) {
+        uint32_t high = i + 1 < size ? (a.data[i + n + 1] << (POWER - r)) & MASK : 0;
+        out[i] = (a.data[i + n] >> r) | high;
+    }
+    size = significant(limb_span(out, size));
+    if (size == 0) {
+        out[0] = 0;
+        return 1;
+    }
+    return size;
+}
+
+bool low_bits_zero(limb_span a, size_t bits)
+{
+    size_t n = bits / POWER, r = bits % POWER;
+    for (size_t i = 0; i < std::min(n, a.size); i++)
+        if (a.data[i] != 0)
+            return false;
+    return n >= a.size || (a.data[n] & ((1u << r) - 1)) == 0;
+}
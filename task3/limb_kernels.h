@@ -0,0 +1,61 @@
+#ifndef LIMB_KERNELS_H
+#define LIMB_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include "limb_span.h"
+
+// low-level arithmetic on absolute values of limb spans (30-bit limbs, signs are ignored);
+// (out) must not overlap with the arguments unless it is said otherwise;
+// compare, add, sub and bitwise kernels use AVX2 or AVX-512 if the processor has them
+
+// compares |a| and |b|, returns -1, 0 or 1
+int compare_limbs(limb_span a, limb_span b);
+
+// out = |a| + |b|, (out) has room for max(a.size, b.size) + 1 limbs and may be the same as a.data,
+// returns the number of written limbs
+size_t add_limbs(limb_span a, limb_span b, uint32_t* out);
+
+// out = |a| - |b|, |a| >= |b|, (out) has room for max(a.size, 1) limbs and may be the same as a.data,
+// returns the size of the result without high zero limbs, but at least 1
+size_t sub_limbs(limb_span a, limb_span b, uint32_t* out);
+
+// out = |a| * |b|, exactly a.size + b.size limbs are written,
+// (scratch) has room for mul_scratch_size(max(a.size, b.size)) limbs
+void mul_limbs(limb_span a, limb_span b, uint32_t* out, uint32_t* scratch);
+size_t mul_scratch_size(size_t size);
+
+// out = |a| * b + carry, b and carry are less than 2^30, (out) has room for a.size limbs
+// and may be the same as a.data, returns the limb which does not fit into a.size limbs
+uint32_t mul_1_limbs(limb_span a, uint32_t b, uint32_t carry, uint32_t* out);
+
+// out = |a| / b, 0 < b < 2^30, (out) has room for a.size limbs and may be the same as a.data,
+// returns |a| % b; high zero limbs of the quotient are written too
+uint32_t div_1_limbs(limb_span a, uint32_t b, uint32_t* out);
+
+// quotient = |a| / |b|, remainder = |a| % |b|, |b| != 0 and a.size >= b.size;
+// a.size - b.size + 1 limbs of the quotient and b.size limbs of the remainder are written,
+// (scratch) has room for div_scratch_size(a.size, b.size) limbs
+void div_limbs(limb_span a, limb_span b, uint32_t* quotient, uint32_t* remainder, uint32_t* scratch);
+size_t div_scratch_size(size_t a_size, size_t b_size);
+
+// out = |a| << shift, (out) has room for a.size + shift / 30 + 1 limbs,
+// returns the size of the result without high zero limbs, but at least 1
+size_t shl_limbs(limb_span a, size_t shift, uint32_t* out);
+
+// out = |a| >> shift, (out) has room for max(a.size - shift / 30, 1) limbs,
+// returns the size of the result without high zero limbs, but at least 1
+size_t shr_limbs(limb_span a, size_t shift, uint32_t* out);
+
+// true if the lowest (bits) bits of |a| are zeros
+bool low_bits_zero(limb_span a, size_t bits);
+
+// out = a & b, a | b, a ^ b limb by limb, a.size == b.size limbs are written, (out) may be the same as a.data
+void and_limbs(limb_span a, limb_span b, uint32_t* out);
+void or_limbs(limb_span a, limb_span b, uint32_t* out);
+void xor_limbs(limb_span a, limb_span b, uint32_t* out);
+
+// out = ~a limb by limb (the 30 bits of each), a.size limbs are written, (out) may be the same as a.data
+void not_limbs(limb_span a, uint32_t* out);
+
+#endif // LIMB_KERNELS_H
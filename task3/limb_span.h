@@ -0,0 +1,26 @@
+#ifndef LIMB_SPAN_H
+#define LIMB_SPAN_H
+
+#include <cstddef>
+#include <cstdint>
+
+// non-owning view of (size) limbs starting from (data), the lowest limb goes first;
+// big_integer and containers convert to it without copying, so algorithms
+// can work on parts of their operands
+struct limb_span {
+    limb_span() : data(nullptr), size(0), sign(1) {}
+    limb_span(uint32_t const* data, size_t size, signed char sign = 1) : data(data), size(size), sign(sign) {}
+
+    // limbs [offset; offset + count), cut to the end of this span
+    limb_span subspan(size_t offset, size_t count) const
+    {
+        offset = offset < size ? offset : size;
+        return limb_span(data + offset, count < size - offset ? count : size - offset, sign);
+    }
+
+    uint32_t const* data;
+    size_t size;
+    signed char sign;
+};
+
+#endif // LIMB_SPAN_H